@@ -0,0 +1,487 @@
+// odds_bench.cpp - Google Benchmark suite for ayejay::odds
+//
+// Build with -DEPOCH_BUILD_BENCHMARKS=ON, then compare runs with:
+//   ayejay_odds_bench --benchmark_format=json --benchmark_out=odds.json
+// Counters are per item (one generated word / one decision) so numbers are
+// comparable across batch sizes and thread counts.
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <ayejay/odds.hpp>
+
+namespace
+{
+    using namespace ayejay::odds;
+
+    constexpr std::uint64_t bench_seed = 0x0DD5'0DD5'0DD5'0DD5ULL;
+
+    // Bounds used across the bounded/odds benchmarks: powers of two, small
+    // and large general bounds, and one with a high rejection rate.
+    void bounds(benchmark::internal::Benchmark* b)
+    {
+        for (const std::int64_t n : { 2LL, 6LL, 64LL, 100LL, 1000LL, 1LL << 20, 1000003LL, 0xC000'0001LL })
+            b->Arg(n);
+    }
+
+    void batch_sizes(benchmark::internal::Benchmark* b)
+    {
+        b->RangeMultiplier(4)->Range(16, 1 << 16);
+    }
+
+    int max_threads()
+    {
+        const unsigned hw = std::thread::hardware_concurrency();
+        return hw == 0 ? 1 : static_cast<int>(hw);
+    }
+
+    // ----------------------------
+    // Raw generators
+    // ----------------------------
+    template <class Engine>
+    void BM_next_u64(benchmark::State& state)
+    {
+        Engine rng(bench_seed);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(rng.next_u64());
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK_TEMPLATE(BM_next_u64, xoshiro256ss);
+    BENCHMARK_TEMPLATE(BM_next_u64, philox4x32);
+    BENCHMARK_TEMPLATE(BM_next_u64, wyrand);
+    BENCHMARK_TEMPLATE(BM_next_u64, romu_duo_jr);
+    BENCHMARK_TEMPLATE(BM_next_u64, xoroshiro128p);
+    BENCHMARK_TEMPLATE(BM_next_u64, pcg64_dxsm);
+    BENCHMARK_TEMPLATE(BM_next_u64, xoshiro256ss_x4);
+    BENCHMARK_TEMPLATE(BM_next_u64, xoshiro256ss_x8);
+
+    template <class Engine>
+    void BM_fill(benchmark::State& state)
+    {
+        Engine rng(bench_seed);
+        std::vector<std::uint64_t> out(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            rng.fill(out);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * state.range(0) * 8);
+    }
+    BENCHMARK_TEMPLATE(BM_fill, xoshiro256ss)->Apply(batch_sizes);
+    BENCHMARK_TEMPLATE(BM_fill, philox4x32)->Apply(batch_sizes);
+    BENCHMARK_TEMPLATE(BM_fill, xoshiro256ss_x4)->Apply(batch_sizes);
+    BENCHMARK_TEMPLATE(BM_fill, xoshiro256ss_x8)->Apply(batch_sizes);
+
+    // O(log n) skip-ahead; items are calls.
+    void BM_advance(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        const auto n = static_cast<std::uint64_t>(state.range(0));
+        for (auto _ : state)
+        {
+            rng.advance(n);
+            benchmark::DoNotOptimize(rng.s);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_advance)->Arg(1000)->Arg(1 << 16)->Arg(1 << 20)->Arg(std::numeric_limits<std::int64_t>::max())->Unit(benchmark::kMicrosecond);
+
+    // Lanes engine pinned to each dispatch level this build and CPU support.
+    void BM_lanes_fill_level(benchmark::State& state)
+    {
+        const auto level = static_cast<simd_level>(state.range(0));
+        if (!simd_level_supported(level))
+        {
+            state.SkipWithError("SIMD level not supported by this build or CPU");
+            return;
+        }
+        xoshiro256ss_x8 rng(bench_seed);
+        std::vector<std::uint64_t> out(4096);
+        for (auto _ : state)
+        {
+            rng.fill(out, level);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(out.size()));
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(out.size()) * 8);
+    }
+    BENCHMARK(BM_lanes_fill_level)
+        ->ArgName("level")
+        ->Arg(static_cast<int>(simd_level::scalar))
+        ->Arg(static_cast<int>(simd_level::neon))
+        ->Arg(static_cast<int>(simd_level::avx2))
+        ->Arg(static_cast<int>(simd_level::avx512));
+
+    // ----------------------------
+    // 64x64 -> 128 multiply paths
+    // ----------------------------
+    // mul_wide is the intrinsic (__int128 / _umul128 / __umulh) where
+    // AYEJAY_ODDS_HAS_MUL_HIGH is set and the 32-bit limb version otherwise;
+    // mul_wide_portable is always the limb version.
+    template <std::uint64_t (*Mul)(std::uint64_t, std::uint64_t, std::uint64_t&)>
+    void BM_mul_wide(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        const std::uint64_t b = static_cast<std::uint64_t>(state.range(0));
+        for (auto _ : state)
+        {
+            std::uint64_t hi = 0;
+            benchmark::DoNotOptimize(Mul(rng.next_u64(), b, hi));
+            benchmark::DoNotOptimize(hi);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK_TEMPLATE(BM_mul_wide, ayejay::odds::detail::mul_wide)->Name("BM_mul_wide_native")->Arg(1000003);
+    BENCHMARK_TEMPLATE(BM_mul_wide, ayejay::odds::detail::mul_wide_portable)->Name("BM_mul_wide_portable")->Arg(1000003);
+
+    // Lemire bounded draw on the limb multiply: what targets without a
+    // native mul-high run inside uniform_bounded.
+    void BM_bounded_lemire_portable(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        const std::uint64_t b = static_cast<std::uint64_t>(state.range(0));
+        const std::uint64_t threshold = ayejay::odds::detail::bounded_threshold(b);
+        for (auto _ : state)
+        {
+            std::uint64_t hi = 0;
+            while (ayejay::odds::detail::mul_wide_portable(rng.next_u64(), b, hi) < threshold) {}
+            benchmark::DoNotOptimize(hi);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_bounded_lemire_portable)->Apply(bounds);
+
+    // Reference point: the old fallback, modulo rejection (a division per draw).
+    void BM_bounded_modulo(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        const std::uint64_t b = static_cast<std::uint64_t>(state.range(0));
+        const std::uint64_t limit = (std::numeric_limits<std::uint64_t>::max() / b) * b;
+        for (auto _ : state)
+        {
+            std::uint64_t x = rng.next_u64();
+            while (x >= limit) x = rng.next_u64();
+            benchmark::DoNotOptimize(x % b);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_bounded_modulo)->Apply(bounds);
+
+    // ----------------------------
+    // Bounded uniform
+    // ----------------------------
+    void BM_uniform_bounded(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        const auto b = static_cast<std::uint64_t>(state.range(0));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(uniform_bounded(rng, b));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_uniform_bounded)->Apply(bounds);
+
+    void BM_bounded_sampler(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        const bounded_sampler<std::uint64_t> sample(static_cast<std::uint64_t>(state.range(0)));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(sample(rng));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_bounded_sampler)->Apply(bounds);
+
+    void BM_uniform_bounded_fill(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        const auto b = static_cast<std::uint32_t>(state.range(0));
+        std::vector<std::uint32_t> out(static_cast<std::size_t>(state.range(1)));
+        for (auto _ : state)
+        {
+            uniform_bounded_fill(rng, b, std::span<std::uint32_t>(out));
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(1));
+    }
+    BENCHMARK(BM_uniform_bounded_fill)
+        ->ArgNames({ "bound", "batch" })
+        ->ArgsProduct({ { 64, 100, 1000003 }, { 64, 1024, 16384 } });
+
+    // ----------------------------
+    // Runtime odds
+    // ----------------------------
+    void BM_one_in(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        const auto b = static_cast<std::uint64_t>(state.range(0));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(one_in(rng, b));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_one_in)->Apply(bounds);
+
+    void BM_one_in_fast(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        const auto b = static_cast<std::uint64_t>(state.range(0));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(one_in_fast(rng, b));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_one_in_fast)->Apply(bounds);
+
+    void BM_one_in_fill(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        const auto b = static_cast<std::uint32_t>(state.range(0));
+        std::unique_ptr<bool[]> out(new bool[static_cast<std::size_t>(state.range(1))]);
+        const std::span<bool> view(out.get(), static_cast<std::size_t>(state.range(1)));
+        for (auto _ : state)
+        {
+            one_in_fill(rng, b, view);
+            benchmark::DoNotOptimize(view.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(1));
+    }
+    BENCHMARK(BM_one_in_fill)
+        ->ArgNames({ "bound", "batch" })
+        ->ArgsProduct({ { 64, 100, 1000003 }, { 64, 1024, 16384 } });
+
+    // 64 decisions per call; items are trials, not calls.
+    void BM_one_in_mask(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        const auto b = static_cast<std::uint64_t>(state.range(0));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(one_in_mask(rng, b));
+        state.SetItemsProcessed(state.iterations() * 64);
+    }
+    BENCHMARK(BM_one_in_mask)->Apply(bounds);
+
+    void BM_bernoulli(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(bernoulli(rng, 0.35));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_bernoulli);
+
+    // ----------------------------
+    // Real / ranged integer / normal / exponential (std:: versions as reference)
+    // ----------------------------
+    void BM_uniform_double(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(uniform_double(rng));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_uniform_double);
+
+    void BM_std_uniform_real(benchmark::State& state)
+    {
+        std::mt19937_64 rng(bench_seed);
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(dist(rng));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_std_uniform_real);
+
+    void BM_uniform_int(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(uniform_int(rng, -50, 49));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_uniform_int);
+
+    void BM_std_uniform_int(benchmark::State& state)
+    {
+        std::mt19937_64 rng(bench_seed);
+        std::uniform_int_distribution<int> dist(-50, 49);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(dist(rng));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_std_uniform_int);
+
+    void BM_normal(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(normal(rng));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_normal);
+
+    void BM_std_normal(benchmark::State& state)
+    {
+        std::mt19937_64 rng(bench_seed);
+        std::normal_distribution<double> dist;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(dist(rng));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_std_normal);
+
+    void BM_exponential(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(exponential(rng));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_exponential);
+
+    void BM_std_exponential(benchmark::State& state)
+    {
+        std::mt19937_64 rng(bench_seed);
+        std::exponential_distribution<double> dist;
+        for (auto _ : state)
+            benchmark::DoNotOptimize(dist(rng));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_std_exponential);
+
+    void BM_normal_fill(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        std::vector<double> out(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            normal_fill(rng, std::span<double>(out));
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_normal_fill)->Arg(1024);
+
+    // ----------------------------
+    // Shuffle / sample
+    // ----------------------------
+    // Items are Fisher-Yates steps (elements).
+    void BM_shuffle(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        std::vector<std::uint32_t> deck(static_cast<std::size_t>(state.range(0)));
+        for (std::size_t i = 0; i < deck.size(); ++i)
+            deck[i] = static_cast<std::uint32_t>(i);
+        for (auto _ : state)
+        {
+            shuffle(rng, std::span<std::uint32_t>(deck));
+            benchmark::DoNotOptimize(deck.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_shuffle)->Arg(52)->Arg(1024)->Arg(1 << 16);
+
+    void BM_sample_k(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        const auto n = static_cast<std::uint32_t>(state.range(0));
+        std::vector<std::uint32_t> out(static_cast<std::size_t>(state.range(1)));
+        for (auto _ : state)
+        {
+            sample_k(rng, n, out.size(), std::span<std::uint32_t>(out));
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(1));
+    }
+    BENCHMARK(BM_sample_k)
+        ->ArgNames({ "n", "k" })
+        ->Args({ 100, 5 })
+        ->Args({ 1000, 500 })
+        ->Args({ 1000000, 1000 });
+
+    // ----------------------------
+    // Compile-time odds
+    // ----------------------------
+    template <std::uint32_t N>
+    void BM_one_in_t(benchmark::State& state)
+    {
+        xoshiro256ss rng(bench_seed);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(one_in_v<N>(rng));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK_TEMPLATE(BM_one_in_t, 2);
+    BENCHMARK_TEMPLATE(BM_one_in_t, 6);
+    BENCHMARK_TEMPLATE(BM_one_in_t, 64);
+    BENCHMARK_TEMPLATE(BM_one_in_t, 100);
+    BENCHMARK_TEMPLATE(BM_one_in_t, 256);
+    BENCHMARK_TEMPLATE(BM_one_in_t, 1000);
+
+    // Named presets through the thread_local default RNG.
+    template <class Preset>
+    void BM_preset(benchmark::State& state, Preset preset)
+    {
+        seed_thread(bench_seed);
+        for (auto _ : state)
+            benchmark::DoNotOptimize(preset());
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK_CAPTURE(BM_preset, p2, [] { return p2(); });
+    BENCHMARK_CAPTURE(BM_preset, p10, [] { return p10(); });
+    BENCHMARK_CAPTURE(BM_preset, p100, [] { return p100(); });
+    BENCHMARK_CAPTURE(BM_preset, p256, [] { return p256(); });
+
+    // ----------------------------
+    // Thread scaling
+    // ----------------------------
+    // thread_local default RNG: no shared state, should scale linearly.
+    void BM_thread_rng_one_in(benchmark::State& state)
+    {
+        for (auto _ : state)
+            benchmark::DoNotOptimize(one_in(100u));
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_thread_rng_one_in)->ThreadRange(1, max_threads())->UseRealTime();
+
+    // Padded per-worker slots in one pool.
+    void BM_rng_pool_next_u64(benchmark::State& state)
+    {
+        static rng_pool pool(static_cast<std::size_t>(max_threads()), bench_seed);
+        rng_pool::handle h = pool.for_worker(static_cast<std::size_t>(state.thread_index()));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(h.next_u64());
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_rng_pool_next_u64)->ThreadRange(1, max_threads())->UseRealTime();
+
+    // End-to-end driver; items are trials.
+    void BM_monte_carlo_one_in(benchmark::State& state)
+    {
+        constexpr std::uint64_t trials = 1ULL << 26;
+        monte_carlo_options opts;
+        opts.threads = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state)
+            benchmark::DoNotOptimize(monte_carlo_one_in(trials, bench_seed, 100u, opts));
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(trials));
+    }
+    BENCHMARK(BM_monte_carlo_one_in)
+        ->ArgName("threads")
+        ->RangeMultiplier(2)
+        ->Range(1, max_threads())
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+} // namespace
+
+BENCHMARK_MAIN();
@@ -1 +1,4 @@
 option(EPOCH_ENABLE_MODULES "Enable C++23 module interface" ON)
+option(EPOCH_BUILD_BENCHMARKS "Build the Google Benchmark suite (ayejay_odds_bench)" OFF)
+option(EPOCH_BUILD_VALIDATE "Build the statistical validation tool (ayejay_odds_validate)" OFF)
+option(EPOCH_ODDS_STATS "Count sampler draws/rejections/bounds per thread (AYEJAY_ODDS_STATS)" OFF)
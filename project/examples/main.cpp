@@ -1,9 +1,33 @@
+#include <array>
+#include <cstdint>
 #include <iostream>
 
 #include <ayejay/odds.hpp>
 // If you enable modules and your toolchain supports them, you can instead:
 // import ayejay.odds;
 
+// Built by the compiler: a seeded loot order and a noise table, identical to
+// what the same calls produce at run time.
+constexpr auto loot_order = []
+{
+    std::array<std::uint16_t, 64> order{};
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = static_cast<std::uint16_t>(i);
+
+    ayejay::odds::xoshiro256ss rng(2024);
+    ayejay::odds::shuffle(rng, std::span<std::uint16_t>(order));
+    return order;
+}();
+
+constexpr auto noise = []
+{
+    std::array<std::uint8_t, 256> table{};
+    ayejay::odds::xoshiro256ss rng(7);
+    for (std::uint8_t& v : table)
+        v = ayejay::odds::uniform_bounded(rng, std::uint8_t{ 200 });
+    return table;
+}();
+
 int main()
 {
     using namespace ayejay::odds;
@@ -21,6 +45,19 @@ int main()
 
     std::cout << "1 in 100 hits: " << hits << "\n";
 
+    // Same experiment, jumping straight from hit to hit.
+    std::size_t skip_hits = 0;
+    for_each_hit(thread_rng(), 100u, trials, [&](std::uint64_t) { ++skip_hits; });
+
+    std::cout << "1 in 100 hits (skip-ahead): " << skip_hits << "\n";
+
+    // Larger runs: spread over all cores, same count for any thread count.
+    const std::uint64_t mc_hits = monte_carlo_one_in(100'000'000, 1337, 100u);
+    std::cout << "1 in 100 hits (monte_carlo, 1e8 trials): " << mc_hits << "\n";
+
+    std::cout << "Compile-time loot order starts: " << loot_order[0] << ", " << loot_order[1] << ", "
+              << loot_order[2] << "; noise[0] = " << int{ noise[0] } << "\n";
+
     if (one_in(37u))
         std::cout << "Lucky 37 triggered.\n";
 
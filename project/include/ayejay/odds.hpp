@@ -0,0 +1,3413 @@
+#pragma once
+// odds.hpp - C++23 "1 in N" odds / probability utilities
+//
+// Features:
+// - Runtime: one_in(N), one_in_fast(N) (single compare), bernoulli(p) (exact)
+// - Fractional odds: m_in_n(m, n), m_in_n_v<M, N>, probability / chance_v<P>
+// - Compile-time: one_in<100>() (constexpr thresholds, compare-only decision)
+// - Presets: ayejay::odds::p100(), p50(), p25(), p10(), p5(), p2(), etc.
+// - Fast, deterministic PRNG (xoshiro256**), seedable, with jump()/long_jump() streams
+//   and O(log n) advance(n).
+// - Alternative engines: wyrand, romu_duo_jr, xoroshiro128p, pcg64_dxsm (uniform_random_bit_engine).
+// - Unbiased bounded uniform generation (no modulo bias, no per-draw division on any target).
+// - Batch APIs: xoshiro256ss::fill, uniform_bounded_fill, one_in_fill.
+// - bounded_sampler<UInt>: runtime bound with the Lemire threshold cached.
+// - Bit-sliced one_in_mask / one_in_bits: 64 trials per ~8 draws.
+// - Geometric skip-ahead (next_hit / for_each_hit): one draw per hit.
+// - binomial / binomial_count: hit count of K trials in O(1) expected time (libm-independent).
+// - uniform_double / uniform_float / uniform_int(lo, hi): toolchain-independent results.
+// - shuffle / sample_k: batched Fisher-Yates (several indices per draw), Floyd sampling.
+// - Ziggurat normal / exponential (compile-time tables, libm-independent).
+// - constexpr sampling: bounded, odds, geometric skip, binomial, shuffle/sample_k, uniform,
+//   ziggurat, pity/ramping and dynamic_weighted_table samplers run in constant expressions
+//   (compile-time tables) with the same results as at run time.
+// - weighted_table: O(1) alias-method draws from weighted loot tables.
+// - dynamic_weighted_table: O(log n) updates and draws (Fenwick tree).
+// - pity_odds / ramping_odds: bad-luck protection with compile-time tables.
+// - philox4x32: counter-based PRNG keyed by (seed, entity, tick).
+// - cache_padded<E> / rng_bank: false-sharing-safe and SoA generator storage.
+// - Versioned 32-byte state encoding, save/restore, seed + draws checkpoints.
+// - Opt-in sampler statistics (AYEJAY_ODDS_STATS): draws, rejections, hot bounds.
+// - Process-wide seed pool: thread start costs no random_device read (seed_strategy).
+// - monte_carlo / monte_carlo_one_in: parallel, bit-identical for any thread count.
+// - Multi-lane SoA engines (xoshiro256ss_x4 / _x8) with AVX2/AVX-512/NEON dispatch.
+//
+// Notes:
+// - Link the ayejay_odds library: SIMD kernels and CPU dispatch, alias-table
+//   builds, the stats registry, seeding and the monte_carlo pool are compiled
+//   once in src/. Everything constexpr or per-draw stays inline here.
+// - Prefer `import ayejay.odds;`. Where named modules are unavailable this
+//   header also works as a header unit (`import <ayejay/odds.hpp>;`) or a
+//   plain #include; all three name the same entities.
+// - Thread-safe by default via thread_local RNG (no locks); rng_pool for explicit per-worker state.
+// - For deterministic replay/testing, call ayejay::odds::seed_thread(...) once per thread,
+//   or set_process_seed(...) before starting threads.
+// - Thread seeds come from a process-wide entropy pool read once (see seed_strategy).
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  #include <intrin.h>
+#endif
+
+// Platforms with a real "which CPU am I on" query (sched_getcpu,
+// GetCurrentProcessorNumberEx). rng_pool::for_current_cpu() exists only here.
+#if defined(__linux__) || defined(_WIN32)
+  #define AYEJAY_ODDS_HAS_CURRENT_CPU 1
+#endif
+
+// Padding unit for per-thread state. GCC warns that the standard constant
+// may change with -mtune, which would silently change this header's layout,
+// so GCC builds pin it to 64 unless overridden.
+#if !defined(AYEJAY_ODDS_CACHE_LINE)
+  #if defined(__cpp_lib_hardware_interference_size) && !(defined(__GNUC__) && !defined(__clang__))
+    #define AYEJAY_ODDS_CACHE_LINE std::hardware_destructive_interference_size
+  #else
+    #define AYEJAY_ODDS_CACHE_LINE 64
+  #endif
+#endif
+
+namespace ayejay::odds
+{
+    // ----------------------------
+    // Small utilities
+    // ----------------------------
+    template <class T>
+    concept unsigned_int =
+        std::is_unsigned_v<T> && std::is_integral_v<T>;
+
+    [[nodiscard]] constexpr std::uint64_t rotl64(std::uint64_t x, int k) noexcept
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    // Anything that produces 64 uniformly random bits per next_u64() call.
+    // Every sampler in this header takes its engine through this concept.
+    template <class E>
+    concept uniform_random_bit_engine = requires(E& e) {
+        { e.next_u64() } -> std::convertible_to<std::uint64_t>;
+    };
+
+// Set when the target has a native 64x64 -> 128 multiply, which mul_wide
+// then uses; elsewhere (32-bit ARM, WASM, ...) it falls back to 32-bit limbs.
+// Either way the bounded paths use Lemire's method and never divide per draw.
+#if defined(__SIZEOF_INT128__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64)))
+  #define AYEJAY_ODDS_HAS_MUL_HIGH 1
+#endif
+
+    namespace detail
+    {
+        // 64x64 -> 128 from four 32x32 -> 64 products (one umull each on
+        // 32-bit ARM, one i64.mul each on WASM). Returns the low word.
+        [[nodiscard]] constexpr std::uint64_t mul_wide_portable(std::uint64_t a, std::uint64_t b, std::uint64_t& hi) noexcept
+        {
+            const std::uint64_t a_lo = a & 0xFFFF'FFFFULL;
+            const std::uint64_t a_hi = a >> 32;
+            const std::uint64_t b_lo = b & 0xFFFF'FFFFULL;
+            const std::uint64_t b_hi = b >> 32;
+
+            const std::uint64_t ll = a_lo * b_lo;
+            const std::uint64_t lh = a_lo * b_hi;
+            const std::uint64_t hl = a_hi * b_lo;
+            const std::uint64_t hh = a_hi * b_hi;
+
+            // Middle column; cannot overflow: (2^32-1) + 2 * (2^32-1)^2 / 2^32 < 2^64.
+            const std::uint64_t mid = (ll >> 32) + (lh & 0xFFFF'FFFFULL) + (hl & 0xFFFF'FFFFULL);
+            hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+            return (mid << 32) | (ll & 0xFFFF'FFFFULL);
+        }
+
+        // Full 64x64 -> 128 product: returns the low word, writes the high word.
+        // Constant evaluation takes the limb path (the intrinsics are not
+        // constexpr); the result is the same bit for bit.
+        [[nodiscard]] constexpr std::uint64_t mul_wide(std::uint64_t a, std::uint64_t b, std::uint64_t& hi) noexcept
+        {
+            if consteval
+            {
+                return mul_wide_portable(a, b, hi);
+            }
+#if !defined(AYEJAY_ODDS_HAS_MUL_HIGH)
+            return mul_wide_portable(a, b, hi);
+#elif defined(__SIZEOF_INT128__)
+            const __uint128_t m = static_cast<__uint128_t>(a) * static_cast<__uint128_t>(b);
+            hi = static_cast<std::uint64_t>(m >> 64);
+            return static_cast<std::uint64_t>(m);
+#elif defined(_M_X64)
+            return _umul128(a, b, &hi);
+#else
+            hi = __umulh(a, b);
+            return a * b;
+#endif
+        }
+    } // namespace detail
+
+    // ----------------------------
+    // Sampler statistics (opt-in: AYEJAY_ODDS_STATS)
+    // ----------------------------
+    // With AYEJAY_ODDS_STATS defined, the bounded-uniform and odds samplers
+    // (uniform_bounded, bounded_sampler, the *_fill forms, one_in, one_in_fast,
+    // m_in_n, one_in_t, m_in_n_t, and sample_k's Floyd paths against n) count,
+    // per thread:
+    //   calls        values / decisions produced, also broken down by bound
+    //   rejections   words thrown away by a rejection loop
+    //   other_draws  words drawn by every other sampler: bernoulli, chance_t,
+    //                one_in_mask / one_in_bits, geometric_skip, binomial, the
+    //                uniform real, normal and exponential forms, shuffle
+    //                batches, weighted_table coins and pity / ramping odds
+    //   draws        all engine words the samplers consumed:
+    //                calls + rejections + other_draws
+    // Raw engine calls (next_u64, fill) made by user code are not counted.
+    // Each thread owns a cache-line-aligned slot that only it writes (relaxed
+    // load + store, no locked instructions), so counting never contends.
+    // Without the macro the hooks expand to nothing and the snapshot
+    // functions return empty results.
+    //
+    // Deltas of thread_stats_snapshot() around a subsystem give its
+    // consumption; hot bounds in stats_snapshot().bounds are the call sites
+    // worth moving to bounded_sampler / one_in_t / the batch APIs. one_in_t
+    // and m_in_n_t count under their own entries (compile_time set), so a
+    // bound already served at compile time is not mistaken for a runtime one.
+#if defined(AYEJAY_ODDS_STATS)
+    inline constexpr bool stats_enabled = true;
+#else
+    inline constexpr bool stats_enabled = false;
+#endif
+
+    struct bound_calls final
+    {
+        std::uint64_t bound = 0;
+        std::uint64_t calls = 0;
+        bool compile_time = false; // one_in_t<N> / m_in_n_t<M, N> decisions
+    };
+
+    struct odds_stats final
+    {
+        std::uint64_t draws = 0;
+        std::uint64_t rejections = 0;
+        std::uint64_t calls = 0;
+        std::uint64_t other_draws = 0;
+
+        // Calls whose bound did not fit the thread's per-bound table.
+        std::uint64_t other_calls = 0;
+
+        // Per-bound call counts, most called first.
+        std::vector<bound_calls> bounds;
+
+        // Threads with a live slot when the snapshot was taken.
+        std::size_t threads = 0;
+    };
+
+#if defined(AYEJAY_ODDS_STATS)
+    namespace detail
+    {
+        // Open-addressed (bound, compile_time) -> calls table; bound 0 marks
+        // a free entry.
+        inline constexpr std::size_t stats_bound_slots = 64;
+        inline constexpr std::size_t stats_bound_probes = 8;
+
+        // Written only by the owning thread; atomics so snapshots from other
+        // threads read whole words.
+        struct alignas(AYEJAY_ODDS_CACHE_LINE) stats_slot final
+        {
+            std::atomic<std::uint64_t> rejections{ 0 };
+            std::atomic<std::uint64_t> calls{ 0 };
+            std::atomic<std::uint64_t> other_draws{ 0 };
+            std::atomic<std::uint64_t> other_calls{ 0 };
+            std::array<std::atomic<std::uint64_t>, stats_bound_slots> bounds{};
+            std::array<std::atomic<std::uint64_t>, stats_bound_slots> counts{};
+            std::array<std::atomic<bool>, stats_bound_slots> compile_time{};
+        };
+
+        inline void stats_bump(std::atomic<std::uint64_t>& c, std::uint64_t n) noexcept
+        {
+            c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        // Registers the slot with the process-wide registry (src/stats.cpp)
+        // and folds its counts into the retired totals on thread exit.
+        struct stats_thread final
+        {
+            stats_slot slot;
+
+            stats_thread();
+            stats_thread(const stats_thread&) = delete;
+            stats_thread& operator=(const stats_thread&) = delete;
+            ~stats_thread();
+        };
+
+        [[nodiscard]] inline stats_slot& thread_stats_slot() noexcept
+        {
+            thread_local stats_thread t;
+            return t.slot;
+        }
+
+        inline void stat_rejection() noexcept
+        {
+            stats_bump(thread_stats_slot().rejections, 1);
+        }
+
+        inline void stat_draws(std::uint64_t n) noexcept
+        {
+            stats_bump(thread_stats_slot().other_draws, n);
+        }
+
+        inline void stat_calls(std::uint64_t bound, std::uint64_t n, bool compile_time) noexcept
+        {
+            stats_slot& slot = thread_stats_slot();
+            stats_bump(slot.calls, n);
+
+            const std::size_t home = static_cast<std::size_t>((bound * 0x9E3779B97F4A7C15ULL) >> 58);
+            for (std::size_t p = 0; bound != 0 && p < stats_bound_probes; ++p)
+            {
+                const std::size_t i = (home + p) % stats_bound_slots;
+                const std::uint64_t key = slot.bounds[i].load(std::memory_order_relaxed);
+                if (key == 0)
+                {
+                    // Flag first: a snapshot that sees the bound sees its flag.
+                    slot.compile_time[i].store(compile_time, std::memory_order_relaxed);
+                    slot.bounds[i].store(bound, std::memory_order_release);
+                }
+                else if (key != bound || slot.compile_time[i].load(std::memory_order_relaxed) != compile_time)
+                {
+                    continue;
+                }
+                stats_bump(slot.counts[i], n);
+                return;
+            }
+            stats_bump(slot.other_calls, n);
+        }
+    } // namespace detail
+
+// `n` calls against `bound`, each consuming one engine word.
+#define AYEJAY_ODDS_STAT_CALLS(bound, n) \
+    do { if !consteval { ::ayejay::odds::detail::stat_calls((bound), (n), false); } } while (0)
+// As above for a compile-time bound (one_in_t, m_in_n_t).
+#define AYEJAY_ODDS_STAT_CONST_CALLS(bound, n) \
+    do { if !consteval { ::ayejay::odds::detail::stat_calls((bound), (n), true); } } while (0)
+// One word rejected (and one more drawn in its place).
+#define AYEJAY_ODDS_STAT_REJECTION() \
+    do { if !consteval { ::ayejay::odds::detail::stat_rejection(); } } while (0)
+// `n` words drawn by a sampler that counts neither calls nor rejections.
+#define AYEJAY_ODDS_STAT_DRAWS(n) \
+    do { if !consteval { ::ayejay::odds::detail::stat_draws((n)); } } while (0)
+#else
+#define AYEJAY_ODDS_STAT_CALLS(bound, n) ((void)0)
+#define AYEJAY_ODDS_STAT_CONST_CALLS(bound, n) ((void)0)
+#define AYEJAY_ODDS_STAT_REJECTION() ((void)0)
+#define AYEJAY_ODDS_STAT_DRAWS(n) ((void)0)
+#endif
+
+    // Totals over all threads, including threads that have exited, since
+    // the last reset_stats().
+    [[nodiscard]] odds_stats stats_snapshot();
+
+    // The calling thread's counters since it first counted (not affected by
+    // reset_stats(); take deltas).
+    [[nodiscard]] odds_stats thread_stats_snapshot();
+
+    // Restarts stats_snapshot() from zero. Counts made concurrently with the
+    // reset may land on either side of it.
+    void reset_stats();
+
+    // ----------------------------
+    // splitmix64 - seeding generator
+    // ----------------------------
+    struct splitmix64 final
+    {
+        std::uint64_t state{};
+
+        constexpr explicit splitmix64(std::uint64_t seed) noexcept : state(seed) {}
+
+        [[nodiscard]] constexpr std::uint64_t next_u64() noexcept
+        {
+            std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+    };
+
+    // ----------------------------
+    // GF(2) polynomial arithmetic modulo a degree-256 polynomial
+    // ----------------------------
+    // Used to skip F2-linear generators ahead: if p is the characteristic
+    // polynomial of the state transition T, then T^n = (x^n mod p)(T).
+    namespace detail
+    {
+        // Degree < 256, bit i = coefficient of x^i. The modulus is
+        // x^256 + low, passed as `low`.
+        using gf2_poly = std::array<std::uint64_t, 4>;
+
+        [[nodiscard]] constexpr gf2_poly gf2_mulx(const gf2_poly& r, const gf2_poly& low) noexcept
+        {
+            const bool carry = (r[3] >> 63) != 0;
+            gf2_poly out{ { r[0] << 1, (r[1] << 1) | (r[0] >> 63), (r[2] << 1) | (r[1] >> 63), (r[3] << 1) | (r[2] >> 63) } };
+            if (carry)
+                for (std::size_t i = 0; i < 4; ++i) out[i] ^= low[i];
+            return out;
+        }
+
+        // a * b mod (x^256 + low), Horner over the bits of a.
+        [[nodiscard]] constexpr gf2_poly gf2_mulmod(const gf2_poly& a, const gf2_poly& b, const gf2_poly& low) noexcept
+        {
+            gf2_poly r{};
+            for (int i = 255; i >= 0; --i)
+            {
+                r = gf2_mulx(r, low);
+                if ((a[static_cast<std::size_t>(i / 64)] >> (i % 64)) & 1ULL)
+                    for (std::size_t w = 0; w < 4; ++w) r[w] ^= b[w];
+            }
+            return r;
+        }
+
+        // base^e mod (x^256 + low), O(log e) multiplications.
+        [[nodiscard]] constexpr gf2_poly gf2_powmod(const gf2_poly& base, std::uint64_t e, const gf2_poly& low) noexcept
+        {
+            gf2_poly r{ { 1, 0, 0, 0 } };
+            for (int bit = 63 - std::countl_zero(e | 1); e != 0 && bit >= 0; --bit)
+            {
+                r = gf2_mulmod(r, r, low);
+                if ((e >> bit) & 1ULL)
+                    r = gf2_mulmod(r, base, low);
+            }
+            return r;
+        }
+
+        // r^(2^k) mod (x^256 + low): k squarings.
+        [[nodiscard]] constexpr gf2_poly gf2_square_n(gf2_poly r, unsigned k, const gf2_poly& low) noexcept
+        {
+            for (unsigned i = 0; i < k; ++i)
+                r = gf2_mulmod(r, r, low);
+            return r;
+        }
+    } // namespace detail
+
+    // ----------------------------
+    // xoshiro256** - fast PRNG
+    // ----------------------------
+    struct xoshiro256ss final
+    {
+        // State must not be all-zero.
+        std::array<std::uint64_t, 4> s{
+            { 0x123456789ABCDEF0ULL, 0xCAFEBABEDEADC0DEULL, 0x0F1E2D3C4B5A6978ULL, 0x1122334455667788ULL }
+        };
+
+        constexpr xoshiro256ss() noexcept = default;
+
+        constexpr explicit xoshiro256ss(std::uint64_t seed) noexcept
+        {
+            seed_with(seed);
+        }
+
+        constexpr void seed_with(std::uint64_t seed) noexcept
+        {
+            splitmix64 sm(seed);
+            s[0] = sm.next_u64();
+            s[1] = sm.next_u64();
+            s[2] = sm.next_u64();
+            s[3] = sm.next_u64();
+
+            // Ensure not all zero.
+            if ((s[0] | s[1] | s[2] | s[3]) == 0ULL)
+            {
+                s[0] = 0x9E3779B97F4A7C15ULL;
+                s[1] = 0xBF58476D1CE4E5B9ULL;
+                s[2] = 0x94D049BB133111EBULL;
+                s[3] = 0xD1B54A32D192ED03ULL;
+            }
+        }
+
+        [[nodiscard]] constexpr std::uint64_t next_u64() noexcept
+        {
+            // xoshiro256** reference implementation (Vigna/Blackman).
+            const std::uint64_t result = rotl64(s[1] * 5ULL, 7) * 9ULL;
+            const std::uint64_t t = s[1] << 17;
+
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+
+            s[2] ^= t;
+            s[3] = rotl64(s[3], 45);
+
+            return result;
+        }
+
+        [[nodiscard]] constexpr std::uint32_t next_u32() noexcept
+        {
+            return static_cast<std::uint32_t>(next_u64() >> 32);
+        }
+
+        // Characteristic polynomial of the state transition, x^256 + char_poly
+        // (Berlekamp-Massey on the output of one state bit).
+        static constexpr std::array<std::uint64_t, 4> char_poly{
+            { 0x9D116F2BB0F0F001ULL, 0x0280002BCEFD1A5EULL, 0x04B4EDCF26259F85ULL, 0x0003C03C3F3ECB19ULL }
+        };
+
+        // Jump polynomials from the reference implementation: x^(2^128) and
+        // x^(2^192) mod the characteristic polynomial (checked in src/xoshiro.cpp).
+        // jump() advances by 2^128 draws, long_jump() by 2^192.
+        static constexpr std::array<std::uint64_t, 4> jump_poly{
+            { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL }
+        };
+        static constexpr std::array<std::uint64_t, 4> long_jump_poly{
+            { 0x76E15D3EFEFDCBBFULL, 0xC5004E441C522FB3ULL, 0x77710069854EE241ULL, 0x39109BB02ACBE635ULL }
+        };
+
+        // Replace the state with p(T) applied to it, where T is one step of
+        // the generator and p a GF(2) polynomial (bit i = coefficient of x^i).
+        constexpr void apply_polynomial(const std::array<std::uint64_t, 4>& poly) noexcept
+        {
+            std::array<std::uint64_t, 4> acc{};
+            for (const std::uint64_t word : poly)
+            {
+                for (int b = 0; b < 64; ++b)
+                {
+                    if (word & (std::uint64_t{1} << b))
+                    {
+                        acc[0] ^= s[0];
+                        acc[1] ^= s[1];
+                        acc[2] ^= s[2];
+                        acc[3] ^= s[3];
+                    }
+                    (void)next_u64();
+                }
+            }
+            s = acc;
+        }
+
+        // x^n mod the characteristic polynomial: applied with
+        // apply_polynomial, it advances the state by n draws.
+        [[nodiscard]] static constexpr std::array<std::uint64_t, 4> advance_poly(std::uint64_t n) noexcept
+        {
+            // Square-and-multiply where "multiply" is by x: a shift.
+            detail::gf2_poly r{ { 1, 0, 0, 0 } };
+            for (int bit = 63 - std::countl_zero(n | 1); n != 0 && bit >= 0; --bit)
+            {
+                r = detail::gf2_mulmod(r, r, char_poly);
+                if ((n >> bit) & 1ULL)
+                    r = detail::gf2_mulx(r, char_poly);
+            }
+            return r;
+        }
+
+        // Same state as n calls to next_u64(), in O(log n) polynomial steps
+        // plus one 256-step apply_polynomial (tens of microseconds). Below
+        // ~2^15 draws, stepping directly is cheaper.
+        constexpr void advance(std::uint64_t n) noexcept
+        {
+            if (n <= (1ULL << 15))
+            {
+                for (std::uint64_t i = 0; i < n; ++i)
+                    (void)next_u64();
+                return;
+            }
+            apply_polynomial(advance_poly(n));
+        }
+
+        constexpr void discard(std::uint64_t n) noexcept { advance(n); }
+
+        // advance(2^128) / advance(2^192), with the polynomials precomputed.
+        constexpr void jump() noexcept { apply_polynomial(jump_poly); }
+        constexpr void long_jump() noexcept { apply_polynomial(long_jump_poly); }
+
+        // Non-overlapping substreams: stream(i) is this state jumped i times,
+        // so each owns 2^128 draws. Partition nodes with long_jump() (2^64
+        // nodes of 2^192) and threads within a node with stream(i).
+        // O(log i): applies jump_poly^i mod the characteristic polynomial.
+        // split() is still cheaper when handing out consecutive streams.
+        [[nodiscard]] constexpr xoshiro256ss stream(std::uint64_t i) const noexcept
+        {
+            xoshiro256ss r = *this;
+            if (i <= 4)
+            {
+                for (std::uint64_t k = 0; k < i; ++k)
+                    r.jump();
+                return r;
+            }
+            r.apply_polynomial(detail::gf2_powmod(jump_poly, i, char_poly));
+            return r;
+        }
+
+        // out[i] = stream(i), one jump per element.
+        constexpr void split(std::span<xoshiro256ss> out) const noexcept
+        {
+            xoshiro256ss r = *this;
+            for (xoshiro256ss& o : out)
+            {
+                o = r;
+                r.jump();
+            }
+        }
+
+        // Bulk generation: same sequence as repeated next_u64() calls, but the
+        // state stays in registers for the whole loop.
+        constexpr void fill(std::span<std::uint64_t> out) noexcept
+        {
+            std::uint64_t s0 = s[0];
+            std::uint64_t s1 = s[1];
+            std::uint64_t s2 = s[2];
+            std::uint64_t s3 = s[3];
+
+            for (std::uint64_t& o : out)
+            {
+                o = rotl64(s1 * 5ULL, 7) * 9ULL;
+                const std::uint64_t t = s1 << 17;
+
+                s2 ^= s0;
+                s3 ^= s1;
+                s1 ^= s2;
+                s0 ^= s3;
+
+                s2 ^= t;
+                s3 = rotl64(s3, 45);
+            }
+
+            s[0] = s0;
+            s[1] = s1;
+            s[2] = s2;
+            s[3] = s3;
+        }
+    };
+
+    // ----------------------------
+    // CPU feature dispatch
+    // ----------------------------
+    enum class simd_level : std::uint8_t
+    {
+        scalar,
+        neon,
+        avx2,
+        avx512,
+    };
+
+    // Best kernel level available on this CPU (detected once).
+    [[nodiscard]] simd_level detected_simd_level() noexcept;
+
+    // True when this build has a kernel for `level` and the CPU can run it
+    // (neon is never supported on x86-64, avx2/avx512 never on ARM). Other
+    // levels passed to fill()/generate() run the scalar kernel, or fault if
+    // the CPU lacks the instructions.
+    [[nodiscard]] bool simd_level_supported(simd_level level) noexcept;
+
+    // ----------------------------
+    // Multi-lane xoshiro256** kernels
+    // ----------------------------
+    namespace detail
+    {
+        // SoA view of `lanes` independent xoshiro256** states.
+        struct lanes_view final
+        {
+            std::uint64_t* s0;
+            std::uint64_t* s1;
+            std::uint64_t* s2;
+            std::uint64_t* s3;
+            std::size_t lanes;
+        };
+
+        // Advances every lane `steps` times, writing out[step * v.lanes + lane]
+        // with the widest kernel `level` allows (src/simd.cpp). Output is
+        // identical for every level.
+        void lanes_generate(const lanes_view& v, std::uint64_t* out, std::size_t steps,
+                            simd_level level) noexcept;
+    } // namespace detail
+
+    // ----------------------------
+    // xoshiro256ss_lanes<L> - L interleaved xoshiro256** streams (SoA)
+    // ----------------------------
+    // Output order is step-major: one word from lane 0, 1, ..., L-1, then the
+    // next step. next_u64() serves that sequence from a one-step buffer, so the
+    // engine also works anywhere a scalar Rng does.
+    template <std::size_t Lanes>
+    struct xoshiro256ss_lanes final
+    {
+        static_assert(Lanes >= 1, "xoshiro256ss_lanes<L>: L must be >= 1");
+
+        static constexpr std::size_t lanes = Lanes;
+
+        // s[word][lane]. No lane may be all-zero.
+        alignas(64) std::array<std::array<std::uint64_t, Lanes>, 4> s{};
+
+        std::array<std::uint64_t, Lanes> buf{};
+        std::size_t buf_pos = Lanes;
+
+        constexpr xoshiro256ss_lanes() noexcept
+            : xoshiro256ss_lanes(0x8BADF00DULL)
+        {
+        }
+
+        constexpr explicit xoshiro256ss_lanes(std::uint64_t seed) noexcept
+        {
+            seed_with(seed);
+        }
+
+        constexpr explicit xoshiro256ss_lanes(std::span<const xoshiro256ss, Lanes> states) noexcept
+        {
+            for (std::size_t i = 0; i < Lanes; ++i)
+                set_lane(i, states[i]);
+        }
+
+        // Lane i is xoshiro256ss(seed).stream(i): lanes never overlap.
+        constexpr void seed_with(std::uint64_t seed) noexcept
+        {
+            xoshiro256ss r(seed);
+            for (std::size_t i = 0; i < Lanes; ++i)
+            {
+                set_lane(i, r);
+                r.jump();
+            }
+            buf_pos = Lanes;
+        }
+
+        [[nodiscard]] constexpr xoshiro256ss lane(std::size_t i) const noexcept
+        {
+            xoshiro256ss r;
+            r.s = { { s[0][i], s[1][i], s[2][i], s[3][i] } };
+            return r;
+        }
+
+        constexpr void set_lane(std::size_t i, const xoshiro256ss& rng) noexcept
+        {
+            for (std::size_t w = 0; w < 4; ++w)
+                s[w][i] = rng.s[w];
+        }
+
+        // One step of every lane: out[i] comes from lane i.
+        constexpr void next_block(std::span<std::uint64_t, Lanes> out) noexcept
+        {
+            for (std::size_t i = 0; i < Lanes; ++i)
+            {
+                out[i] = rotl64(s[1][i] * 5ULL, 7) * 9ULL;
+                const std::uint64_t t = s[1][i] << 17;
+
+                s[2][i] ^= s[0][i];
+                s[3][i] ^= s[1][i];
+                s[1][i] ^= s[2][i];
+                s[0][i] ^= s[3][i];
+
+                s[2][i] ^= t;
+                s[3][i] = rotl64(s[3][i], 45);
+            }
+        }
+
+        [[nodiscard]] constexpr std::uint64_t next_u64() noexcept
+        {
+            if (buf_pos == Lanes)
+            {
+                next_block(buf);
+                buf_pos = 0;
+            }
+            return buf[buf_pos++];
+        }
+
+        [[nodiscard]] constexpr std::uint32_t next_u32() noexcept
+        {
+            return static_cast<std::uint32_t>(next_u64() >> 32);
+        }
+
+        // Bulk generation through the CPU-dispatched kernel. Same sequence as
+        // repeated next_u64() calls.
+        void fill(std::span<std::uint64_t> out) noexcept
+        {
+            fill(out, detected_simd_level());
+        }
+
+        // As above with an explicit kernel level (see simd_level_supported).
+        void fill(std::span<std::uint64_t> out, simd_level level) noexcept
+        {
+            std::size_t i = 0;
+            while (i < out.size() && buf_pos < Lanes)
+                out[i++] = buf[buf_pos++];
+
+            const std::size_t steps = (out.size() - i) / Lanes;
+            if (steps != 0)
+            {
+                const detail::lanes_view v{ s[0].data(), s[1].data(), s[2].data(), s[3].data(), Lanes };
+                detail::lanes_generate(v, out.data() + i, steps, level);
+                i += steps * Lanes;
+            }
+
+            while (i < out.size())
+                out[i++] = next_u64();
+        }
+    };
+
+    using xoshiro256ss_x4 = xoshiro256ss_lanes<4>;
+    using xoshiro256ss_x8 = xoshiro256ss_lanes<8>;
+
+    // ----------------------------
+    // philox4x32 - counter-based (stateless) PRNG, Philox4x32-10
+    // ----------------------------
+    // Every 128-bit output block is a pure function of (key, counter), so a
+    // draw depends only on what it is for, not on which thread made it or in
+    // what order. The key is the 64-bit seed; the counter is
+    // (block, tick, entity_lo, entity_hi), giving each (seed, entity, tick)
+    // its own stream of 2^33 draws. next_u64() walks that stream, so the
+    // type drops in wherever an Rng is expected.
+    struct philox4x32 final
+    {
+        using block_type = std::array<std::uint32_t, 4>;
+        using key_type = std::array<std::uint32_t, 2>;
+
+        key_type key{};
+        block_type ctr{};
+
+        std::array<std::uint64_t, 2> buf{};
+        std::uint32_t buf_pos = 2;
+
+        constexpr philox4x32() noexcept = default;
+
+        constexpr explicit philox4x32(std::uint64_t seed) noexcept
+        {
+            seed_with(seed);
+        }
+
+        constexpr philox4x32(std::uint64_t seed, std::uint64_t entity, std::uint32_t tick) noexcept
+        {
+            seed_with(seed);
+            ctr[1] = tick;
+            ctr[2] = static_cast<std::uint32_t>(entity);
+            ctr[3] = static_cast<std::uint32_t>(entity >> 32);
+        }
+
+        constexpr void seed_with(std::uint64_t seed) noexcept
+        {
+            key = { { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) } };
+            ctr = {};
+            buf_pos = 2;
+        }
+
+        // The Philox4x32-10 bijection (Salmon et al., Random123).
+        [[nodiscard]] static constexpr block_type block(block_type c, key_type k) noexcept
+        {
+            for (int round = 0; round < 10; ++round)
+            {
+                if (round != 0)
+                {
+                    k[0] += 0x9E3779B9U;
+                    k[1] += 0xBB67AE85U;
+                }
+
+                const std::uint64_t p0 = std::uint64_t{0xD2511F53U} * c[0];
+                const std::uint64_t p1 = std::uint64_t{0xCD9E8D57U} * c[2];
+                c = { { static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k[0], static_cast<std::uint32_t>(p1),
+                        static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k[1], static_cast<std::uint32_t>(p0) } };
+            }
+            return c;
+        }
+
+        // Draw `index` of the (seed, entity, tick) stream, with no engine state.
+        [[nodiscard]] static constexpr std::uint64_t at(std::uint64_t seed, std::uint64_t entity,
+                                                        std::uint32_t tick, std::uint64_t index) noexcept
+        {
+            const block_type c{ { static_cast<std::uint32_t>(index >> 1), tick,
+                                  static_cast<std::uint32_t>(entity), static_cast<std::uint32_t>(entity >> 32) } };
+            const key_type k{ { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) } };
+            const block_type r = block(c, k);
+            const std::size_t w = static_cast<std::size_t>(index & 1) * 2;
+            return (static_cast<std::uint64_t>(r[w + 1]) << 32) | r[w];
+        }
+
+        [[nodiscard]] constexpr std::uint64_t next_u64() noexcept
+        {
+            if (buf_pos == 2)
+            {
+                const block_type r = block(ctr, key);
+                ++ctr[0];
+                buf[0] = (static_cast<std::uint64_t>(r[1]) << 32) | r[0];
+                buf[1] = (static_cast<std::uint64_t>(r[3]) << 32) | r[2];
+                buf_pos = 0;
+            }
+            return buf[buf_pos++];
+        }
+
+        [[nodiscard]] constexpr std::uint32_t next_u32() noexcept
+        {
+            return static_cast<std::uint32_t>(next_u64() >> 32);
+        }
+
+        // Skip n draws in O(1).
+        constexpr void discard(std::uint64_t n) noexcept
+        {
+            // Position in draws = 2 * blocks consumed - buffered words left.
+            const std::uint64_t pos = 2 * static_cast<std::uint64_t>(ctr[0]) - (2 - buf_pos) + n;
+            ctr[0] = static_cast<std::uint32_t>(pos >> 1);
+            buf_pos = 2;
+            if (pos & 1)
+                (void)next_u64();
+        }
+
+        constexpr void fill(std::span<std::uint64_t> out) noexcept
+        {
+            for (std::uint64_t& o : out)
+                o = next_u64();
+        }
+    };
+
+    // ----------------------------
+    // Alternative engines
+    // ----------------------------
+    // Same interface as xoshiro256ss (seed constructor, seed_with, next_u64,
+    // next_u32), seeded through splitmix64. Pick by state size and quality:
+    //   wyrand        8 bytes   fastest, for large per-entity arrays
+    //   romu_duo_jr   16 bytes  very fast; no jump, fine for games
+    //   xoroshiro128p 16 bytes  weak low bits: use for floats (top bits) only
+    //   pcg64_dxsm    32 bytes  128-bit LCG, strongest statistically
+    // xoshiro256ss remains the default (jump streams, lanes, advance).
+
+    // wyrand (Wang Yi): Weyl sequence through a 64x64 -> 128 mix.
+    struct wyrand final
+    {
+        std::uint64_t state = 0;
+
+        constexpr wyrand() noexcept = default;
+        constexpr explicit wyrand(std::uint64_t seed) noexcept { seed_with(seed); }
+
+        constexpr void seed_with(std::uint64_t seed) noexcept { state = splitmix64(seed).next_u64(); }
+
+        [[nodiscard]] constexpr std::uint64_t next_u64() noexcept
+        {
+            state += 0xA0761D6478BD642FULL;
+            std::uint64_t hi = 0;
+            const std::uint64_t lo = detail::mul_wide(state, state ^ 0xE7037ED1A0B428DBULL, hi);
+            return hi ^ lo;
+        }
+
+        [[nodiscard]] constexpr std::uint32_t next_u32() noexcept { return static_cast<std::uint32_t>(next_u64() >> 32); }
+    };
+
+    // RomuDuoJr (Overton): two words, one multiply, no additions in the
+    // critical path.
+    struct romu_duo_jr final
+    {
+        std::uint64_t x = 0x9E3779B97F4A7C15ULL;
+        std::uint64_t y = 0xD1B54A32D192ED03ULL;
+
+        constexpr romu_duo_jr() noexcept = default;
+        constexpr explicit romu_duo_jr(std::uint64_t seed) noexcept { seed_with(seed); }
+
+        constexpr void seed_with(std::uint64_t seed) noexcept
+        {
+            splitmix64 sm(seed);
+            x = sm.next_u64();
+            y = sm.next_u64();
+            if ((x | y) == 0) y = 0xD1B54A32D192ED03ULL;
+        }
+
+        [[nodiscard]] constexpr std::uint64_t next_u64() noexcept
+        {
+            const std::uint64_t xp = x;
+            x = 15241094284759029579ULL * y;
+            y = rotl64(y - xp, 27);
+            return xp;
+        }
+
+        [[nodiscard]] constexpr std::uint32_t next_u32() noexcept { return static_cast<std::uint32_t>(next_u64() >> 32); }
+    };
+
+    // xoroshiro128+ (24, 16, 37). The lowest bits are weak (linear); fine
+    // for uniform_double / uniform_float, which only use the top bits.
+    struct xoroshiro128p final
+    {
+        std::array<std::uint64_t, 2> s{ { 0x9E3779B97F4A7C15ULL, 0xBF58476D1CE4E5B9ULL } };
+
+        constexpr xoroshiro128p() noexcept = default;
+        constexpr explicit xoroshiro128p(std::uint64_t seed) noexcept { seed_with(seed); }
+
+        constexpr void seed_with(std::uint64_t seed) noexcept
+        {
+            splitmix64 sm(seed);
+            s[0] = sm.next_u64();
+            s[1] = sm.next_u64();
+            if ((s[0] | s[1]) == 0) s[1] = 0xBF58476D1CE4E5B9ULL;
+        }
+
+        [[nodiscard]] constexpr std::uint64_t next_u64() noexcept
+        {
+            const std::uint64_t s0 = s[0];
+            std::uint64_t s1 = s[1];
+            const std::uint64_t result = s0 + s1;
+
+            s1 ^= s0;
+            s[0] = rotl64(s0, 24) ^ s1 ^ (s1 << 16);
+            s[1] = rotl64(s1, 37);
+            return result;
+        }
+
+        [[nodiscard]] constexpr std::uint32_t next_u32() noexcept { return static_cast<std::uint32_t>(next_u64() >> 32); }
+    };
+
+    // PCG64 DXSM (O'Neill; NumPy's default): 128-bit LCG with the cheap
+    // 64-bit multiplier, output mixed from the pre-step state.
+    struct pcg64_dxsm final
+    {
+        static constexpr std::uint64_t cheap_multiplier = 0xDA942042E4DD58B5ULL;
+
+        std::uint64_t state_hi = 0;
+        std::uint64_t state_lo = 0;
+        std::uint64_t inc_hi = 0;
+        std::uint64_t inc_lo = 1;
+
+        constexpr pcg64_dxsm() noexcept = default;
+        constexpr explicit pcg64_dxsm(std::uint64_t seed) noexcept { seed_with(seed); }
+
+        // PCG seeding: state = 0, inc = 2 * seq + 1, step, state += init, step.
+        constexpr void seed_with(std::uint64_t seed) noexcept
+        {
+            splitmix64 sm(seed);
+            const std::uint64_t init_hi = sm.next_u64();
+            const std::uint64_t init_lo = sm.next_u64();
+            const std::uint64_t seq_hi = sm.next_u64();
+            const std::uint64_t seq_lo = sm.next_u64();
+
+            inc_hi = (seq_hi << 1) | (seq_lo >> 63);
+            inc_lo = (seq_lo << 1) | 1ULL;
+            state_hi = 0;
+            state_lo = 0;
+            step();
+            const std::uint64_t lo = state_lo + init_lo;
+            state_hi += init_hi + (lo < state_lo ? 1 : 0);
+            state_lo = lo;
+            step();
+        }
+
+        [[nodiscard]] constexpr std::uint64_t next_u64() noexcept
+        {
+            std::uint64_t hi = state_hi;
+            const std::uint64_t lo = state_lo | 1ULL;
+            hi ^= hi >> 32;
+            hi *= cheap_multiplier;
+            hi ^= hi >> 48;
+            hi *= lo;
+            step();
+            return hi;
+        }
+
+        [[nodiscard]] constexpr std::uint32_t next_u32() noexcept { return static_cast<std::uint32_t>(next_u64() >> 32); }
+
+    private:
+        // state = state * cheap_multiplier + inc (mod 2^128).
+        constexpr void step() noexcept
+        {
+            std::uint64_t carry_hi = 0;
+            const std::uint64_t lo = detail::mul_wide(state_lo, cheap_multiplier, carry_hi);
+            const std::uint64_t hi = state_hi * cheap_multiplier + carry_hi;
+
+            state_lo = lo + inc_lo;
+            state_hi = hi + inc_hi + (state_lo < lo ? 1 : 0);
+        }
+    };
+
+    static_assert(sizeof(wyrand) == 8);
+    static_assert(sizeof(romu_duo_jr) == 16);
+    static_assert(sizeof(xoroshiro128p) == 16);
+    static_assert(sizeof(pcg64_dxsm) == 32);
+    static_assert(uniform_random_bit_engine<xoshiro256ss> && uniform_random_bit_engine<philox4x32> &&
+                  uniform_random_bit_engine<wyrand> && uniform_random_bit_engine<romu_duo_jr> &&
+                  uniform_random_bit_engine<xoroshiro128p> && uniform_random_bit_engine<pcg64_dxsm>);
+
+    // ----------------------------
+    // Thread-local default RNG
+    // ----------------------------
+    namespace detail
+    {
+        // Fresh std::random_device entropy (src/platform.cpp).
+        [[nodiscard]] std::uint64_t entropy_seed() noexcept;
+    } // namespace detail
+
+    // How a thread's default RNG gets its seed on first use.
+    enum class seed_strategy : std::uint8_t
+    {
+        // Default. std::random_device is read once per process; each thread
+        // seed is splitmix64 of (pool seed, thread start counter).
+        process_pool,
+        // Like process_pool, but the pool seed comes from set_process_seed().
+        // Reproducible as long as threads first touch the RNG in a fixed order.
+        user_seed,
+        // std::random_device on every thread's first use (one or more
+        // syscalls per thread start).
+        per_thread_entropy,
+    };
+
+    namespace detail
+    {
+        inline std::atomic<seed_strategy> seeding{ seed_strategy::process_pool };
+        inline std::atomic<std::uint64_t> user_pool_seed{ 0 };
+        inline std::atomic<std::uint64_t> thread_counter{ 0 };
+
+        [[nodiscard]] inline std::uint64_t process_entropy() noexcept
+        {
+            static const std::uint64_t seed = entropy_seed();
+            return seed;
+        }
+
+        // Seed number `index` of a pool: the index-th splitmix64 output.
+        [[nodiscard]] constexpr std::uint64_t derive_seed(std::uint64_t pool, std::uint64_t index) noexcept
+        {
+            splitmix64 sm(pool + index * 0x9E3779B97F4A7C15ULL);
+            return sm.next_u64();
+        }
+
+        [[nodiscard]] inline std::uint64_t thread_seed() noexcept
+        {
+            switch (seeding.load(std::memory_order_relaxed))
+            {
+            case seed_strategy::per_thread_entropy:
+                return entropy_seed();
+            case seed_strategy::user_seed:
+                return derive_seed(user_pool_seed.load(std::memory_order_relaxed),
+                                   thread_counter.fetch_add(1, std::memory_order_relaxed));
+            case seed_strategy::process_pool:
+            default:
+                return derive_seed(process_entropy(), thread_counter.fetch_add(1, std::memory_order_relaxed));
+            }
+        }
+
+        // Function-local rather than a thread_local variable template: GCC
+        // skips the dynamic initialiser of the latter.
+        template <class Engine>
+        [[nodiscard]] inline Engine& tl_engine() noexcept
+        {
+            thread_local Engine engine{ thread_seed() };
+            return engine;
+        }
+    } // namespace detail
+
+    // Engine behind thread_rng() and the rng-less overloads (one_in(N),
+    // p100(), ...). Override by defining AYEJAY_ODDS_DEFAULT_ENGINE to one of
+    // the engines above before including this header (the same way in every
+    // translation unit).
+#if defined(AYEJAY_ODDS_DEFAULT_ENGINE)
+    using default_engine = AYEJAY_ODDS_DEFAULT_ENGINE;
+#else
+    using default_engine = xoshiro256ss;
+#endif
+
+    // Strategy changes affect threads that have not used thread_rng() yet;
+    // set it at startup, before spawning workers.
+    inline void set_seed_strategy(seed_strategy strategy) noexcept
+    {
+        detail::seeding.store(strategy, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] inline seed_strategy get_seed_strategy() noexcept
+    {
+        return detail::seeding.load(std::memory_order_relaxed);
+    }
+
+    // Selects seed_strategy::user_seed with this pool seed and restarts the
+    // thread counter.
+    inline void set_process_seed(std::uint64_t seed) noexcept
+    {
+        detail::user_pool_seed.store(seed, std::memory_order_relaxed);
+        detail::thread_counter.store(0, std::memory_order_relaxed);
+        detail::seeding.store(seed_strategy::user_seed, std::memory_order_relaxed);
+    }
+
+    // Pays the one random_device read now (e.g. during load) instead of on
+    // the first thread that draws.
+    inline void warm_seed_pool() noexcept
+    {
+        (void)detail::process_entropy();
+    }
+
+    // This thread's instance of Engine; each engine type has its own.
+    template <uniform_random_bit_engine Engine = default_engine>
+    [[nodiscard]] inline Engine& thread_rng() noexcept
+    {
+        return detail::tl_engine<Engine>();
+    }
+
+    template <uniform_random_bit_engine Engine = default_engine>
+    inline void seed_thread(std::uint64_t seed) noexcept
+    {
+        detail::tl_engine<Engine>() = Engine(seed);
+    }
+
+    // ----------------------------
+    // State serialization: canonical encoding, snapshots, checkpoints
+    // ----------------------------
+    // Canonical xoshiro256ss encoding (format version 1): 32 bytes, words
+    // s[0]..s[3] in order, each little-endian, independent of host byte
+    // order. Store state_format_version next to persisted snapshots; it
+    // changes only if this layout does. For in-process rollback the engine
+    // types are also trivially copyable, so memcpy snapshots are valid.
+    inline constexpr std::uint32_t state_format_version = 1;
+    inline constexpr std::size_t xoshiro256ss_state_size = 32;
+    inline constexpr std::size_t checkpoint_state_size = 16;
+
+    static_assert(std::is_trivially_copyable_v<splitmix64>);
+    static_assert(std::is_trivially_copyable_v<xoshiro256ss>);
+    static_assert(std::is_trivially_copyable_v<xoshiro256ss_x4>);
+    static_assert(std::is_trivially_copyable_v<xoshiro256ss_x8>);
+    static_assert(std::is_trivially_copyable_v<philox4x32>);
+    static_assert(sizeof(xoshiro256ss) == xoshiro256ss_state_size);
+
+    namespace detail
+    {
+        constexpr void store_le64(std::span<std::byte> out, std::uint64_t v) noexcept
+        {
+            for (std::size_t i = 0; i < 8; ++i)
+                out[i] = static_cast<std::byte>(v >> (8 * i));
+        }
+
+        [[nodiscard]] constexpr std::uint64_t load_le64(std::span<const std::byte> in) noexcept
+        {
+            std::uint64_t v = 0;
+            for (std::size_t i = 0; i < 8; ++i)
+                v |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+            return v;
+        }
+    } // namespace detail
+
+    constexpr void save(const xoshiro256ss& rng, std::span<std::byte, xoshiro256ss_state_size> out) noexcept
+    {
+        for (std::size_t w = 0; w < 4; ++w)
+            detail::store_le64(std::span<std::byte>(out).subspan(8 * w, 8), rng.s[w]);
+    }
+
+    // Returns false (and leaves rng unchanged) for the all-zero state, which
+    // xoshiro256** cannot leave and no valid save produces.
+    [[nodiscard]] constexpr bool restore(xoshiro256ss& rng, std::span<const std::byte, xoshiro256ss_state_size> in) noexcept
+    {
+        std::array<std::uint64_t, 4> st{};
+        for (std::size_t w = 0; w < 4; ++w)
+            st[w] = detail::load_le64(std::span<const std::byte>(in).subspan(8 * w, 8));
+        if ((st[0] | st[1] | st[2] | st[3]) == 0) return false;
+
+        rng.s = st;
+        return true;
+    }
+
+    // Delta form: 16 bytes instead of 32 for engines that started from a
+    // seed. state() is xoshiro256ss(seed) advanced by `draws`, O(log draws).
+    struct xoshiro256ss_checkpoint final
+    {
+        std::uint64_t seed = 0;
+        std::uint64_t draws = 0;
+
+        [[nodiscard]] constexpr xoshiro256ss state() const noexcept
+        {
+            xoshiro256ss r(seed);
+            r.advance(draws);
+            return r;
+        }
+
+        friend constexpr bool operator==(const xoshiro256ss_checkpoint&, const xoshiro256ss_checkpoint&) = default;
+    };
+
+    // Encoding: seed then draws, little-endian.
+    constexpr void save(const xoshiro256ss_checkpoint& cp, std::span<std::byte, checkpoint_state_size> out) noexcept
+    {
+        detail::store_le64(std::span<std::byte>(out).subspan(0, 8), cp.seed);
+        detail::store_le64(std::span<std::byte>(out).subspan(8, 8), cp.draws);
+    }
+
+    constexpr void restore(xoshiro256ss_checkpoint& cp, std::span<const std::byte, checkpoint_state_size> in) noexcept
+    {
+        cp.seed = detail::load_le64(std::span<const std::byte>(in).subspan(0, 8));
+        cp.draws = detail::load_le64(std::span<const std::byte>(in).subspan(8, 8));
+    }
+
+    // xoshiro256ss that counts its draws, so its position can be taken as a
+    // checkpoint at any time. Usable anywhere an Rng is.
+    class counting_xoshiro256ss final
+    {
+    public:
+        constexpr counting_xoshiro256ss() noexcept : counting_xoshiro256ss(0) {}
+        constexpr explicit counting_xoshiro256ss(std::uint64_t seed) noexcept : rng_(seed), seed_(seed) {}
+        constexpr explicit counting_xoshiro256ss(const xoshiro256ss_checkpoint& cp) noexcept
+            : rng_(cp.state()), seed_(cp.seed), draws_(cp.draws)
+        {
+        }
+
+        [[nodiscard]] constexpr std::uint64_t next_u64() noexcept
+        {
+            ++draws_;
+            return rng_.next_u64();
+        }
+
+        [[nodiscard]] constexpr std::uint32_t next_u32() noexcept
+        {
+            ++draws_;
+            return rng_.next_u32();
+        }
+
+        constexpr void fill(std::span<std::uint64_t> out) noexcept
+        {
+            draws_ += out.size();
+            rng_.fill(out);
+        }
+
+        [[nodiscard]] constexpr xoshiro256ss_checkpoint checkpoint() const noexcept { return { seed_, draws_ }; }
+        [[nodiscard]] constexpr std::uint64_t draws() const noexcept { return draws_; }
+        [[nodiscard]] constexpr const xoshiro256ss& engine() const noexcept { return rng_; }
+
+    private:
+        xoshiro256ss rng_;
+        std::uint64_t seed_ = 0;
+        std::uint64_t draws_ = 0;
+    };
+
+    // ----------------------------
+    // Cache-line padded and SoA generator storage
+    // ----------------------------
+    inline constexpr std::size_t cache_line_size = AYEJAY_ODDS_CACHE_LINE;
+
+    // One engine per cache line, for arrays of per-thread generators: no two
+    // elements of a std::vector<cache_padded<E>> share a line.
+    template <class Engine>
+    struct alignas(cache_line_size) cache_padded final
+    {
+        Engine rng;
+
+        [[nodiscard]] constexpr std::uint64_t next_u64() noexcept { return rng.next_u64(); }
+        [[nodiscard]] constexpr std::uint32_t next_u32() noexcept { return rng.next_u32(); }
+
+        constexpr void fill(std::span<std::uint64_t> out) noexcept
+            requires requires(Engine& e) { e.fill(out); }
+        {
+            rng.fill(out);
+        }
+    };
+
+    using padded_xoshiro256ss = cache_padded<xoshiro256ss>;
+
+    // rng_bank - N xoshiro256** states as four separate word arrays, so one
+    // kernel call advances every entity's generator together (same
+    // CPU-dispatched kernels as xoshiro256ss_lanes).
+    class rng_bank final
+    {
+    public:
+        rng_bank() = default;
+
+        // Entity i is seeded with the i-th splitmix64 output of `seed`
+        // (independent streams; use set() with jump streams for a
+        // non-overlap guarantee).
+        constexpr rng_bank(std::size_t n, std::uint64_t seed)
+            : s0_(n), s1_(n), s2_(n), s3_(n)
+        {
+            splitmix64 sm(seed);
+            for (std::size_t i = 0; i < n; ++i)
+                set(i, xoshiro256ss(sm.next_u64()));
+        }
+
+        constexpr explicit rng_bank(std::span<const xoshiro256ss> states)
+            : s0_(states.size()), s1_(states.size()), s2_(states.size()), s3_(states.size())
+        {
+            for (std::size_t i = 0; i < states.size(); ++i)
+                set(i, states[i]);
+        }
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return s0_.size(); }
+
+        [[nodiscard]] constexpr xoshiro256ss get(std::size_t i) const noexcept
+        {
+            xoshiro256ss r;
+            r.s = { { s0_[i], s1_[i], s2_[i], s3_[i] } };
+            return r;
+        }
+
+        constexpr void set(std::size_t i, const xoshiro256ss& rng) noexcept
+        {
+            s0_[i] = rng.s[0];
+            s1_[i] = rng.s[1];
+            s2_[i] = rng.s[2];
+            s3_[i] = rng.s[3];
+        }
+
+        // Advance entity i alone.
+        [[nodiscard]] constexpr std::uint64_t next(std::size_t i) noexcept
+        {
+            xoshiro256ss r = get(i);
+            const std::uint64_t x = r.next_u64();
+            set(i, r);
+            return x;
+        }
+
+        // Advance every entity `steps` times: out[step * size() + i] is entity
+        // i's output. out.size() must be at least steps * size().
+        void generate(std::span<std::uint64_t> out, std::size_t steps = 1) noexcept
+        {
+            generate(out, steps, detected_simd_level());
+        }
+
+        void generate(std::span<std::uint64_t> out, std::size_t steps, simd_level level) noexcept
+        {
+            const detail::lanes_view v{ s0_.data(), s1_.data(), s2_.data(), s3_.data(), size() };
+            detail::lanes_generate(v, out.data(), steps, level);
+        }
+
+        // Raw state words (word w of every entity), e.g. for memcpy snapshots
+        // of a range of entities.
+        [[nodiscard]] constexpr std::span<std::uint64_t> words(std::size_t w) noexcept
+        {
+            switch (w)
+            {
+            case 0: return s0_;
+            case 1: return s1_;
+            case 2: return s2_;
+            default: return s3_;
+            }
+        }
+
+        // Canonical encoding of entities [first, first + out.size() / 32),
+        // back to back (see save(const xoshiro256ss&, ...)).
+        constexpr void save(std::size_t first, std::span<std::byte> out) const noexcept
+        {
+            for (std::size_t k = 0; k + xoshiro256ss_state_size <= out.size(); k += xoshiro256ss_state_size)
+                ::ayejay::odds::save(get(first + k / xoshiro256ss_state_size),
+                                     out.subspan(k).first<xoshiro256ss_state_size>());
+        }
+
+        // Inverse of save(); stops at (and returns false for) the first
+        // invalid entry, leaving it and later entities unchanged.
+        [[nodiscard]] constexpr bool restore(std::size_t first, std::span<const std::byte> in) noexcept
+        {
+            for (std::size_t k = 0; k + xoshiro256ss_state_size <= in.size(); k += xoshiro256ss_state_size)
+            {
+                xoshiro256ss r;
+                if (!::ayejay::odds::restore(r, in.subspan(k).first<xoshiro256ss_state_size>()))
+                    return false;
+                set(first + k / xoshiro256ss_state_size, r);
+            }
+            return true;
+        }
+
+    private:
+        std::vector<std::uint64_t> s0_;
+        std::vector<std::uint64_t> s1_;
+        std::vector<std::uint64_t> s2_;
+        std::vector<std::uint64_t> s3_;
+    };
+
+    // ----------------------------
+    // rng_pool - explicit per-worker generators (no TLS lookup)
+    // ----------------------------
+    // One cache-line-padded xoshiro256ss per worker, seeded as jump streams
+    // of one master seed (guaranteed non-overlapping). A handle is a plain
+    // pointer to one slot: cheap to copy, usable as an Rng, and safe to carry
+    // inside a coroutine that resumes on another thread. A slot must only be
+    // used by one thread at a time.
+#if defined(AYEJAY_ODDS_HAS_CURRENT_CPU)
+    namespace detail
+    {
+        // Index of the CPU the calling thread is running on (src/platform.cpp).
+        [[nodiscard]] std::size_t current_cpu() noexcept;
+    } // namespace detail
+#endif
+
+    class rng_pool final
+    {
+    public:
+        class handle final
+        {
+        public:
+            constexpr handle() noexcept = default;
+            constexpr explicit handle(xoshiro256ss& rng) noexcept : rng_(&rng) {}
+
+            [[nodiscard]] constexpr std::uint64_t next_u64() noexcept { return rng_->next_u64(); }
+            [[nodiscard]] constexpr std::uint32_t next_u32() noexcept { return rng_->next_u32(); }
+            constexpr void fill(std::span<std::uint64_t> out) noexcept { rng_->fill(out); }
+
+            [[nodiscard]] constexpr xoshiro256ss& engine() const noexcept { return *rng_; }
+
+        private:
+            xoshiro256ss* rng_ = nullptr;
+        };
+
+        rng_pool(std::size_t workers, std::uint64_t seed)
+            : slots_(workers == 0 ? 1 : workers)
+        {
+            xoshiro256ss r(seed);
+            for (padded_xoshiro256ss& slot : slots_)
+            {
+                slot.rng = r;
+                r.jump();
+            }
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return slots_.size(); }
+
+        [[nodiscard]] handle for_worker(std::size_t worker_id) noexcept
+        {
+            return handle(slots_[worker_id % slots_.size()].rng);
+        }
+
+#if defined(AYEJAY_ODDS_HAS_CURRENT_CPU)
+        // Slot picked by the CPU the caller is running on (sched_getcpu on
+        // Linux, GetCurrentProcessorNumberEx on Windows; not offered where
+        // no CPU id exists). Only race-free when each CPU runs a single
+        // pinned worker and size() covers every CPU index; otherwise index
+        // by worker id.
+        [[nodiscard]] handle for_current_cpu() noexcept
+        {
+            return for_worker(detail::current_cpu());
+        }
+#endif
+
+        [[nodiscard]] xoshiro256ss& operator[](std::size_t worker_id) noexcept
+        {
+            return slots_[worker_id].rng;
+        }
+
+    private:
+        std::vector<padded_xoshiro256ss> slots_;
+    };
+
+    // ----------------------------
+    // Unbiased bounded uniform: [0, bound-1]
+    // Using Lemire-style multiplication + rejection
+    // ----------------------------
+    namespace detail
+    {
+        // Rejection threshold for bound b (b not a power of two): 2^64 mod b.
+        [[nodiscard]] constexpr std::uint64_t bounded_threshold(std::uint64_t b) noexcept
+        {
+            return (std::uint64_t{0} - b) % b;
+        }
+
+        // One accept/reject step for a raw word x. On accept, writes the
+        // bounded value to out and returns true.
+        [[nodiscard]] constexpr bool bounded_accept(std::uint64_t x, std::uint64_t b,
+                                                 std::uint64_t threshold, std::uint64_t& out) noexcept
+        {
+            return mul_wide(x, b, out) >= threshold;
+        }
+
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr std::uint64_t bounded_draw(Rng& rng, std::uint64_t b, std::uint64_t threshold) noexcept
+        {
+            std::uint64_t r = 0;
+            while (!bounded_accept(rng.next_u64(), b, threshold, r))
+                AYEJAY_ODDS_STAT_REJECTION();
+            return r;
+        }
+
+        // Single draw without a cached threshold. The division is only needed
+        // when the low word lands below b (probability b/2^64).
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr std::uint64_t bounded_draw_lazy(Rng& rng, std::uint64_t b) noexcept
+        {
+            std::uint64_t hi = 0;
+            std::uint64_t lo = mul_wide(rng.next_u64(), b, hi);
+            if (lo < b)
+            {
+                const std::uint64_t threshold = bounded_threshold(b);
+                while (lo < threshold)
+                {
+                    AYEJAY_ODDS_STAT_REJECTION();
+                    lo = mul_wide(rng.next_u64(), b, hi);
+                }
+            }
+            return hi;
+        }
+
+        // Batch driver: raw words are produced in blocks (using rng.fill when
+        // the engine has it), then mapped in a branch-light loop. The rare
+        // rejected slot is redrawn from the scalar path.
+        template <uniform_random_bit_engine Rng, class Sink>
+        constexpr void bounded_fill(Rng& rng, std::uint64_t b, std::uint64_t threshold, bool pow2,
+                                 std::size_t count, Sink&& sink) noexcept
+        {
+            constexpr std::size_t block = 64;
+            std::array<std::uint64_t, block> raw{};
+            AYEJAY_ODDS_STAT_CALLS(b, count);
+
+            for (std::size_t base = 0; base < count; base += block)
+            {
+                const std::size_t n = (count - base < block) ? (count - base) : block;
+                const std::span<std::uint64_t> words(raw.data(), n);
+                if constexpr (requires { rng.fill(words); })
+                    rng.fill(words);
+                else
+                    for (std::uint64_t& w : words) w = rng.next_u64();
+
+                if (pow2)
+                {
+                    const std::uint64_t mask = b - 1ULL;
+                    for (std::size_t i = 0; i < n; ++i)
+                        sink(base + i, raw[i] & mask);
+                    continue;
+                }
+
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    std::uint64_t r = 0;
+                    if (!bounded_accept(raw[i], b, threshold, r))
+                    {
+                        AYEJAY_ODDS_STAT_REJECTION();
+                        r = bounded_draw(rng, b, threshold);
+                    }
+                    sink(base + i, r);
+                }
+            }
+        }
+    } // namespace detail
+
+    template <unsigned_int UInt, uniform_random_bit_engine Rng>
+    [[nodiscard]] constexpr UInt uniform_bounded(Rng& rng, UInt bound) noexcept
+    {
+        // Precondition: bound != 0.
+        if (bound == 0) return 0;
+
+        AYEJAY_ODDS_STAT_CALLS(static_cast<std::uint64_t>(bound), 1);
+
+        // Fast path for power-of-two bounds.
+        if ((bound & (bound - 1)) == 0)
+        {
+            return static_cast<UInt>(rng.next_u64() & (static_cast<std::uint64_t>(bound) - 1ULL));
+        }
+
+        return static_cast<UInt>(detail::bounded_draw_lazy(rng, static_cast<std::uint64_t>(bound)));
+    }
+
+    // ----------------------------
+    // bounded_sampler<UInt> - uniform_bounded with the bound fixed up front
+    // ----------------------------
+    // Construction does the one division (the rejection threshold) and the
+    // power-of-two check; draws through the sampler never divide. Intended for
+    // bounds that are runtime values but change rarely (config, drop tables).
+    template <unsigned_int UInt>
+    class bounded_sampler final
+    {
+    public:
+        constexpr bounded_sampler() noexcept = default;
+
+        // Precondition: bound != 0 (a zero bound always yields 0).
+        constexpr explicit bounded_sampler(UInt bound) noexcept
+            : bound_(static_cast<std::uint64_t>(bound))
+        {
+            if (bound_ == 0)
+            {
+                bound_ = 1;
+                pow2_ = true;
+            }
+            else if ((bound_ & (bound_ - 1)) == 0)
+            {
+                pow2_ = true;
+            }
+            else
+            {
+                pow2_ = false;
+                threshold_ = detail::bounded_threshold(bound_);
+            }
+        }
+
+        [[nodiscard]] constexpr UInt bound() const noexcept { return static_cast<UInt>(bound_); }
+
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr UInt operator()(Rng& rng) const noexcept
+        {
+            AYEJAY_ODDS_STAT_CALLS(bound_, 1);
+            if (pow2_)
+                return static_cast<UInt>(rng.next_u64() & (bound_ - 1ULL));
+            return static_cast<UInt>(detail::bounded_draw(rng, bound_, threshold_));
+        }
+
+        template <uniform_random_bit_engine Rng>
+        constexpr void fill(Rng& rng, std::type_identity_t<std::span<UInt>> out) const noexcept
+        {
+            detail::bounded_fill(rng, bound_, threshold_, pow2_, out.size(),
+                [out](std::size_t i, std::uint64_t r) noexcept { out[i] = static_cast<UInt>(r); });
+        }
+
+        // Bernoulli(1/bound) through the cached threshold.
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr bool one_in(Rng& rng) const noexcept
+        {
+            return bound_ <= 1 || (*this)(rng) == 0;
+        }
+
+        template <uniform_random_bit_engine Rng>
+        constexpr void one_in_fill(Rng& rng, std::span<bool> out) const noexcept
+        {
+            if (bound_ <= 1)
+            {
+                for (bool& o : out) o = true;
+                return;
+            }
+
+            detail::bounded_fill(rng, bound_, threshold_, pow2_, out.size(),
+                [out](std::size_t i, std::uint64_t r) noexcept { out[i] = (r == 0); });
+        }
+
+    private:
+        std::uint64_t bound_ = 1;
+        std::uint64_t threshold_ = 0;
+        bool pow2_ = true;
+    };
+
+    // ----------------------------
+    // Batched bounded uniform: out[i] in [0, bound-1]
+    // Threshold is computed once per call, not once per element.
+    // ----------------------------
+    template <unsigned_int UInt, uniform_random_bit_engine Rng>
+    constexpr void uniform_bounded_fill(Rng& rng, UInt bound, std::type_identity_t<std::span<UInt>> out) noexcept
+    {
+        bounded_sampler<UInt>(bound).fill(rng, out);
+    }
+
+    // ----------------------------
+    // Uniform real / ranged integer distributions
+    // ----------------------------
+    // Defined purely in terms of next_u64() and IEEE operations, so the same
+    // seed gives the same values on every compiler and standard library
+    // (unlike std::uniform_*_distribution, whose algorithms are unspecified).
+    // The ranged forms round a multiply and an add separately, so this needs
+    // a build that does not fuse them into an FMA. GCC contracts across
+    // statements by default (also with -std=c++23), so it needs
+    // -ffp-contract=off; the ayejay_odds CMake target passes it to every
+    // consumer. Clang's default is fine, MSVC's too without /fp:contract or
+    // /fp:fast.
+
+    // [0, 1) on the 2^-53 grid: top 53 bits times 2^-53, no division.
+    template <uniform_random_bit_engine Rng>
+    [[nodiscard]] constexpr double uniform_double(Rng& rng) noexcept
+    {
+        AYEJAY_ODDS_STAT_DRAWS(1);
+        return static_cast<double>(rng.next_u64() >> 11) * 0x1.0p-53;
+    }
+
+    // [0, 1) on the 2^-24 grid.
+    template <uniform_random_bit_engine Rng>
+    [[nodiscard]] constexpr float uniform_float(Rng& rng) noexcept
+    {
+        AYEJAY_ODDS_STAT_DRAWS(1);
+        return static_cast<float>(rng.next_u64() >> 40) * 0x1.0p-24f;
+    }
+
+    namespace detail
+    {
+        // std::nextafter(x, -inf) for finite x, usable in constant expressions.
+        template <class F, class Bits>
+        [[nodiscard]] constexpr F next_down(F x) noexcept
+        {
+            if (x == F(0)) return -std::numeric_limits<F>::denorm_min();
+            const Bits b = std::bit_cast<Bits>(x);
+            return std::bit_cast<F>(x > F(0) ? static_cast<Bits>(b - 1) : static_cast<Bits>(b + 1));
+        }
+    } // namespace detail
+
+    // [lo, hi). Precondition: lo < hi, hi - lo finite.
+    template <uniform_random_bit_engine Rng>
+    [[nodiscard]] constexpr double uniform_double(Rng& rng, double lo, double hi) noexcept
+    {
+        // Two roundings; see the section comment for the flags that keep a
+        // compiler from fusing them into one FMA.
+        const double scaled = (hi - lo) * uniform_double(rng);
+        const double r = lo + scaled;
+        return r < hi ? r : detail::next_down<double, std::uint64_t>(hi);
+    }
+
+    template <uniform_random_bit_engine Rng>
+    [[nodiscard]] constexpr float uniform_float(Rng& rng, float lo, float hi) noexcept
+    {
+        const float scaled = (hi - lo) * uniform_float(rng);
+        const float r = lo + scaled;
+        return r < hi ? r : detail::next_down<float, std::uint32_t>(hi);
+    }
+
+    [[nodiscard]] inline double uniform_double() noexcept { return uniform_double(thread_rng()); }
+    [[nodiscard]] inline float uniform_float() noexcept { return uniform_float(thread_rng()); }
+    [[nodiscard]] inline double uniform_double(double lo, double hi) noexcept { return uniform_double(thread_rng(), lo, hi); }
+    [[nodiscard]] inline float uniform_float(float lo, float hi) noexcept { return uniform_float(thread_rng(), lo, hi); }
+
+    namespace detail
+    {
+        // Raw words in 64-word blocks (rng.fill when available), handed to
+        // sink(i, word) in order; same words as a next_u64() loop.
+        template <uniform_random_bit_engine Rng, class Sink>
+        constexpr void for_each_word(Rng& rng, std::size_t count, Sink&& sink) noexcept
+        {
+            constexpr std::size_t block = 64;
+            std::array<std::uint64_t, block> raw{};
+
+            for (std::size_t base = 0; base < count; base += block)
+            {
+                const std::size_t n = (count - base < block) ? (count - base) : block;
+                const std::span<std::uint64_t> words(raw.data(), n);
+                if constexpr (requires { rng.fill(words); })
+                    rng.fill(words);
+                else
+                    for (std::uint64_t& w : words) w = rng.next_u64();
+                AYEJAY_ODDS_STAT_DRAWS(n);
+
+                for (std::size_t i = 0; i < n; ++i)
+                    sink(base + i, raw[i]);
+            }
+        }
+    } // namespace detail
+
+    // Batch forms, element-for-element equal to the scalar calls.
+    template <uniform_random_bit_engine Rng>
+    constexpr void uniform_double_fill(Rng& rng, std::span<double> out) noexcept
+    {
+        detail::for_each_word(rng, out.size(),
+            [out](std::size_t i, std::uint64_t x) noexcept { out[i] = static_cast<double>(x >> 11) * 0x1.0p-53; });
+    }
+
+    template <uniform_random_bit_engine Rng>
+    constexpr void uniform_float_fill(Rng& rng, std::span<float> out) noexcept
+    {
+        detail::for_each_word(rng, out.size(),
+            [out](std::size_t i, std::uint64_t x) noexcept { out[i] = static_cast<float>(x >> 40) * 0x1.0p-24f; });
+    }
+
+    // Uniform in the closed range [lo, hi] for any integer type, signed or
+    // not. The full range of the type is one raw draw; otherwise the offset
+    // from lo comes from uniform_bounded. Precondition: lo <= hi.
+    template <class Int, uniform_random_bit_engine Rng>
+        requires(std::is_integral_v<Int> && !std::is_same_v<Int, bool>)
+    [[nodiscard]] constexpr Int uniform_int(Rng& rng, Int lo, Int hi) noexcept
+    {
+        using U = std::make_unsigned_t<Int>;
+        const U span = static_cast<U>(static_cast<U>(hi) - static_cast<U>(lo));
+
+        U offset = 0;
+        if (span == std::numeric_limits<U>::max())
+        {
+            AYEJAY_ODDS_STAT_DRAWS(1);
+            offset = static_cast<U>(rng.next_u64());
+        }
+        else
+            offset = uniform_bounded<U>(rng, static_cast<U>(span + 1));
+
+        return static_cast<Int>(static_cast<U>(static_cast<U>(lo) + offset));
+    }
+
+    template <class Int>
+        requires(std::is_integral_v<Int> && !std::is_same_v<Int, bool>)
+    [[nodiscard]] inline Int uniform_int(Int lo, Int hi) noexcept
+    {
+        return uniform_int(thread_rng(), lo, hi);
+    }
+
+    // ----------------------------
+    // Shuffle / sample without replacement
+    // ----------------------------
+    // Fisher-Yates steps are drawn in batches: one 64-bit word is multiplied
+    // by n, n-1, ..., n-k+1 in turn, each high word being one index and the
+    // low word carrying on (Brackett-Rozinsky & Lemire, "Batched Ranged Random
+    // Integer Generation", 2024). The rejection threshold (a division) is only
+    // computed when the final low word lands below the bound product, which
+    // for the batch sizes used here is rare.
+    namespace detail
+    {
+        inline constexpr std::size_t max_shuffle_batch = 6;
+
+        // Largest batch whose bound product stays below 2^64 with room to
+        // spare, so the rare threshold path is rarely taken.
+        [[nodiscard]] constexpr std::size_t shuffle_batch(std::uint64_t n) noexcept
+        {
+            if (n > (1ULL << 30)) return 1;
+            if (n > (1ULL << 19)) return 2;
+            if (n > (1ULL << 14)) return 3;
+            if (n > (1ULL << 11)) return 4;
+            if (n > (1ULL << 9)) return 5;
+            return 6;
+        }
+
+        // idx[i] uniform in [0, n - i) for i < k, all from (usually) one draw.
+        template <uniform_random_bit_engine Rng>
+        constexpr void batched_indices(Rng& rng, std::uint64_t n, std::size_t k, std::uint64_t* idx) noexcept
+        {
+            AYEJAY_ODDS_STAT_DRAWS(1);
+            std::uint64_t r = rng.next_u64();
+            for (std::size_t i = 0; i < k; ++i)
+                r = mul_wide(r, n - i, idx[i]);
+
+            std::uint64_t product = n;
+            for (std::size_t i = 1; i < k; ++i)
+                product *= n - i;
+
+            if (r < product)
+            {
+                const std::uint64_t threshold = bounded_threshold(product);
+                while (r < threshold)
+                {
+                    AYEJAY_ODDS_STAT_REJECTION();
+                    r = rng.next_u64();
+                    for (std::size_t i = 0; i < k; ++i)
+                        r = mul_wide(r, n - i, idx[i]);
+                }
+            }
+        }
+
+        // Runs the last `steps` Fisher-Yates steps: afterwards the final
+        // `steps` elements are a uniform random ordered sample of v.
+        template <class T, uniform_random_bit_engine Rng>
+        constexpr void shuffle_tail(Rng& rng, std::span<T> v, std::size_t steps) noexcept(std::is_nothrow_swappable_v<T>)
+        {
+            std::uint64_t i = v.size();
+            const std::uint64_t stop = i - (steps < i ? steps : i);
+            std::array<std::uint64_t, max_shuffle_batch> idx{};
+
+            while (i > 1 && i > stop)
+            {
+                std::size_t k = shuffle_batch(i);
+                if (k > i - 1) k = static_cast<std::size_t>(i - 1);
+                if (k > i - stop) k = static_cast<std::size_t>(i - stop);
+
+                batched_indices(rng, i, k, idx.data());
+                for (std::size_t j = 0; j < k; ++j)
+                {
+                    using std::swap;
+                    swap(v[static_cast<std::size_t>(i - 1 - j)], v[static_cast<std::size_t>(idx[j])]);
+                }
+                i -= k;
+            }
+        }
+    } // namespace detail
+
+    // Uniform random permutation of v (every order equally likely).
+    template <class T, uniform_random_bit_engine Rng = xoshiro256ss>
+    constexpr void shuffle(Rng& rng, std::span<T> v) noexcept(std::is_nothrow_swappable_v<T>)
+    {
+        detail::shuffle_tail(rng, v, v.size());
+    }
+
+    template <class T>
+    inline void shuffle(std::span<T> v) noexcept(std::is_nothrow_swappable_v<T>)
+    {
+        shuffle(thread_rng(), v);
+    }
+
+    // k distinct values from [0, n) into out[0, k), every k-subset equally
+    // likely. Preconditions: k <= n, out.size() >= k. The order of the values
+    // in out is unspecified (it is not a uniform permutation for small k).
+    //   small k:  Floyd's algorithm, membership by linear scan of out.
+    //   dense:    partial batched Fisher-Yates over [0, n) (O(n) scratch).
+    //   sparse:   Floyd's algorithm with a hash set (O(k) scratch); during
+    //             constant evaluation the linear scan (same values, O(k^2)).
+    template <unsigned_int UInt, uniform_random_bit_engine Rng>
+    constexpr void sample_k(Rng& rng, UInt n, std::size_t k, std::type_identity_t<std::span<UInt>> out)
+    {
+        constexpr std::size_t linear_max = 16;
+
+        if (k == 0) return;
+
+        bool linear = k <= linear_max;
+        if consteval
+        {
+            linear = linear || static_cast<std::uint64_t>(n) > 4 * static_cast<std::uint64_t>(k);
+        }
+
+        if (linear)
+        {
+            // Floyd draws one bounded value per output; counted against n.
+            AYEJAY_ODDS_STAT_CALLS(static_cast<std::uint64_t>(n), k);
+            std::size_t m = 0;
+            for (std::uint64_t j = n - k; j < n; ++j)
+            {
+                const UInt t = static_cast<UInt>(detail::bounded_draw_lazy(rng, j + 1));
+                bool seen = false;
+                for (std::size_t q = 0; q < m; ++q)
+                    seen |= (out[q] == t);
+                out[m++] = seen ? static_cast<UInt>(j) : t;
+            }
+            return;
+        }
+
+        if (static_cast<std::uint64_t>(n) <= 4 * static_cast<std::uint64_t>(k))
+        {
+            std::vector<UInt> pool(static_cast<std::size_t>(n));
+            for (std::size_t i = 0; i < pool.size(); ++i)
+                pool[i] = static_cast<UInt>(i);
+
+            detail::shuffle_tail(rng, std::span<UInt>(pool), k);
+            for (std::size_t i = 0; i < k; ++i)
+                out[i] = pool[pool.size() - k + i];
+            return;
+        }
+
+        AYEJAY_ODDS_STAT_CALLS(static_cast<std::uint64_t>(n), k);
+        std::unordered_set<UInt> chosen;
+        chosen.reserve(k);
+        std::size_t m = 0;
+        for (std::uint64_t j = n - k; j < n; ++j)
+        {
+            const UInt t = static_cast<UInt>(detail::bounded_draw_lazy(rng, j + 1));
+            const UInt v = chosen.insert(t).second ? t : static_cast<UInt>(j);
+            if (v != t) chosen.insert(v);
+            out[m++] = v;
+        }
+    }
+
+    template <unsigned_int UInt>
+    inline void sample_k(UInt n, std::size_t k, std::type_identity_t<std::span<UInt>> out)
+    {
+        sample_k(thread_rng(), n, k, out);
+    }
+
+    // ----------------------------
+    // Runtime odds: "true with probability 1/bound"
+    // ----------------------------
+    // Exact: the low product word is only checked against the rejection
+    // threshold when it lands below bound (probability bound/2^64).
+    template <unsigned_int UInt = std::uint32_t, uniform_random_bit_engine Rng = xoshiro256ss>
+    [[nodiscard]] constexpr bool one_in(Rng& rng, UInt bound) noexcept
+    {
+        if (bound <= 1) return true;
+        return uniform_bounded<UInt>(rng, bound) == 0;
+    }
+
+    template <unsigned_int UInt = std::uint32_t>
+    [[nodiscard]] inline bool one_in(UInt bound) noexcept
+    {
+        return one_in<UInt>(thread_rng(), bound);
+    }
+
+    // Batched runtime odds: out[i] = one_in(rng, bound).
+    template <unsigned_int UInt = std::uint32_t, uniform_random_bit_engine Rng = xoshiro256ss>
+    constexpr void one_in_fill(Rng& rng, UInt bound, std::span<bool> out) noexcept
+    {
+        bounded_sampler<UInt>(bound).one_in_fill(rng, out);
+    }
+
+    // ----------------------------
+    // Rejection-free odds: one draw, no retry
+    // ----------------------------
+    // one_in_fast(rng, N) is true iff next_u64() < ceil(2^64 / N), computed as
+    // mul-high(x, N) == 0. The hit probability is ceil(2^64/N) / 2^64, i.e.
+    // 1/N plus less than 2^-64. Use one_in (or one_in_t<N>) when exactness matters.
+    template <unsigned_int UInt = std::uint32_t, uniform_random_bit_engine Rng = xoshiro256ss>
+    [[nodiscard]] constexpr bool one_in_fast(Rng& rng, UInt bound) noexcept
+    {
+        if (bound <= 1) return true;
+
+        AYEJAY_ODDS_STAT_CALLS(static_cast<std::uint64_t>(bound), 1);
+        std::uint64_t hi = 0;
+        (void)detail::mul_wide(rng.next_u64(), static_cast<std::uint64_t>(bound), hi);
+        return hi == 0;
+    }
+
+    template <unsigned_int UInt = std::uint32_t>
+    [[nodiscard]] inline bool one_in_fast(UInt bound) noexcept
+    {
+        return one_in_fast<UInt>(thread_rng(), bound);
+    }
+
+    // ----------------------------
+    // bernoulli(rng, p): "true with probability p", exact for every double p
+    // ----------------------------
+    // Compares the random bit stream against the binary expansion of p one
+    // 64-bit word at a time. The first word decides unless it equals p's
+    // leading word (probability 2^-64), so the common cost is one draw plus
+    // one compare; for p >= 2^-12 the expansion fits in that first word.
+    template <uniform_random_bit_engine Rng>
+    [[nodiscard]] constexpr bool bernoulli(Rng& rng, double p) noexcept
+    {
+        if (!(p > 0.0)) return false; // also NaN
+        if (p >= 1.0) return true;
+
+        // p = mant * 2^-shift exactly.
+        const std::uint64_t bits = std::bit_cast<std::uint64_t>(p);
+        const int biased_exp = static_cast<int>(bits >> 52);
+        std::uint64_t mant = bits & ((std::uint64_t{1} << 52) - 1ULL);
+        int shift = 1074;
+        if (biased_exp != 0)
+        {
+            mant |= std::uint64_t{1} << 52;
+            shift = 1075 - biased_exp;
+        }
+
+        for (int word_end = 64;; word_end += 64)
+        {
+            // Bits [word_end - 64, word_end) of p's fraction.
+            const int left = word_end - shift;
+            std::uint64_t pw = 0;
+            if (left >= 0) pw = mant << left;
+            else if (left > -64) pw = mant >> -left;
+
+            AYEJAY_ODDS_STAT_DRAWS(1);
+            const std::uint64_t x = rng.next_u64();
+            if (x != pw) return x < pw;
+            if (left >= 0) return false; // p has no bits left; the stream is >= p
+        }
+    }
+
+    [[nodiscard]] inline bool bernoulli(double p) noexcept
+    {
+        return bernoulli(thread_rng(), p);
+    }
+
+    // ----------------------------
+    // probability - fixed-point chance: P = threshold / 2^64 (or exactly 1)
+    // ----------------------------
+    // Converted once (at compile time or config load); a decision is one draw
+    // and one compare, with no float -> int conversion on the hot path.
+    // ratio() and from_double() round down by less than 2^-64.
+    // Structural, so it can be a template argument (see chance_t).
+    struct probability final
+    {
+        std::uint64_t threshold = 0;
+        bool certain = false;
+
+        [[nodiscard]] static constexpr probability never() noexcept { return {}; }
+        [[nodiscard]] static constexpr probability always() noexcept { return { 0, true }; }
+
+        // m in n, e.g. ratio(3, 7). m >= n is certain; m == 0 or n == 0
+        // (including 0 in 0) is never, as in m_in_n().
+        [[nodiscard]] static constexpr probability ratio(std::uint64_t m, std::uint64_t n) noexcept
+        {
+            if (n == 0 || m == 0) return never();
+            if (m >= n) return always();
+
+            // floor(m * 2^64 / n) by binary long division.
+            std::uint64_t q = 0;
+            std::uint64_t r = m;
+            for (int i = 0; i < 64; ++i)
+            {
+                const bool bit = r >= n - r; // 2r >= n without overflow
+                r = bit ? r - (n - r) : r << 1;
+                q = (q << 1) | (bit ? 1ULL : 0ULL);
+            }
+            return { q, false };
+        }
+
+        [[nodiscard]] static constexpr probability from_double(double p) noexcept
+        {
+            if (!(p > 0.0)) return never();
+            if (p >= 1.0) return always();
+            return { static_cast<std::uint64_t>(p * 0x1.0p64), false };
+        }
+
+        // percent(0.35) == 0.35%.
+        [[nodiscard]] static constexpr probability percent(double pct) noexcept
+        {
+            return from_double(pct / 100.0);
+        }
+
+        [[nodiscard]] constexpr double value() const noexcept
+        {
+            return certain ? 1.0 : static_cast<double>(threshold) * 0x1.0p-64;
+        }
+
+        friend constexpr bool operator==(const probability&, const probability&) noexcept = default;
+    };
+
+    template <uniform_random_bit_engine Rng>
+    [[nodiscard]] constexpr bool bernoulli(Rng& rng, probability p) noexcept
+    {
+        if (p.certain) return true;
+        AYEJAY_ODDS_STAT_DRAWS(1);
+        return rng.next_u64() < p.threshold;
+    }
+
+    [[nodiscard]] inline bool bernoulli(probability p) noexcept
+    {
+        return bernoulli(thread_rng(), p);
+    }
+
+    // ----------------------------
+    // Runtime m-in-n odds: "true with probability m/n", exact
+    // ----------------------------
+    // Same edge cases as probability::ratio: m >= n is certain; m == 0 or
+    // n == 0 (including 0 in 0) is never.
+    template <unsigned_int UInt = std::uint32_t, uniform_random_bit_engine Rng = xoshiro256ss>
+    [[nodiscard]] constexpr bool m_in_n(Rng& rng, UInt m, UInt n) noexcept
+    {
+        if (m == 0 || n == 0) return false;
+        if (m >= n) return true;
+        return uniform_bounded<UInt>(rng, n) < m;
+    }
+
+    template <unsigned_int UInt = std::uint32_t>
+    [[nodiscard]] inline bool m_in_n(UInt m, UInt n) noexcept
+    {
+        return m_in_n<UInt>(thread_rng(), m, n);
+    }
+
+    // ----------------------------
+    // Bit-sliced odds: 64 independent "1 in N" trials per call, one per bit
+    // ----------------------------
+    // Each bit lane compares its own random bit stream against the binary
+    // expansion of 1/N (most significant digit first); one generated word
+    // supplies one digit for all 64 lanes. Every digit settles about half of
+    // the undecided lanes, so a full mask costs ~8 draws for any N instead of
+    // 64. Exact: digits past the first 64 come from long division.
+    namespace detail
+    {
+        // floor(2^64 / n) for n >= 2: the first 64 binary digits of 1/n.
+        [[nodiscard]] constexpr std::uint64_t recip_lead(std::uint64_t n) noexcept
+        {
+            constexpr std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+            return max / n + ((max % n == n - 1) ? 1 : 0);
+        }
+
+        // AND of k words beats the digit comparator (~7.3 draws) only for small k.
+        inline constexpr int pow2_mask_max_k = 7;
+
+        // lead = floor(2^64 / n), rem = 2^64 mod n, n >= 2.
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr std::uint64_t recip_mask(Rng& rng, std::uint64_t n,
+                                                         std::uint64_t lead, std::uint64_t rem) noexcept
+        {
+            std::uint64_t undecided = ~std::uint64_t{0};
+            std::uint64_t hits = 0;
+
+            for (int i = 63; i >= 0 && undecided != 0; --i)
+            {
+                AYEJAY_ODDS_STAT_DRAWS(1);
+                const std::uint64_t w = rng.next_u64();
+                if ((lead >> i) & 1ULL)
+                {
+                    hits |= undecided & ~w;
+                    undecided &= w;
+                }
+                else
+                {
+                    undecided &= ~w;
+                }
+            }
+
+            // Only reached when a lane matched all 64 leading digits.
+            while (undecided != 0)
+            {
+                const bool digit = rem >= n - rem; // 2*rem >= n without overflow
+                rem = digit ? rem - (n - rem) : rem << 1;
+
+                AYEJAY_ODDS_STAT_DRAWS(1);
+                const std::uint64_t w = rng.next_u64();
+                if (digit)
+                {
+                    hits |= undecided & ~w;
+                    undecided &= w;
+                }
+                else
+                {
+                    undecided &= ~w;
+                }
+            }
+            return hits;
+        }
+
+        // 1 in 2^k: a lane hits iff all k of its bits are set.
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr std::uint64_t pow2_mask(Rng& rng, int k) noexcept
+        {
+            AYEJAY_ODDS_STAT_DRAWS(static_cast<std::uint64_t>(k));
+            std::uint64_t m = ~std::uint64_t{0};
+            for (int i = 0; i < k; ++i)
+                m &= rng.next_u64();
+            return m;
+        }
+    } // namespace detail
+
+    template <unsigned_int UInt = std::uint32_t, uniform_random_bit_engine Rng = xoshiro256ss>
+    [[nodiscard]] constexpr std::uint64_t one_in_mask(Rng& rng, UInt bound) noexcept
+    {
+        if (bound <= 1) return ~std::uint64_t{0};
+
+        const std::uint64_t n = static_cast<std::uint64_t>(bound);
+        if ((n & (n - 1)) == 0 && std::countr_zero(n) <= detail::pow2_mask_max_k)
+            return detail::pow2_mask(rng, std::countr_zero(n));
+
+        const std::uint64_t lead = detail::recip_lead(n);
+        return detail::recip_mask(rng, n, lead, std::uint64_t{0} - lead * n);
+    }
+
+    // Bitset fill: bit i of out[w] is trial w*64 + i. The division for 1/N's
+    // leading digits is paid once per call.
+    template <unsigned_int UInt = std::uint32_t, uniform_random_bit_engine Rng = xoshiro256ss>
+    constexpr void one_in_bits(Rng& rng, UInt bound, std::span<std::uint64_t> out) noexcept
+    {
+        const std::uint64_t n = static_cast<std::uint64_t>(bound);
+        if (n <= 1)
+        {
+            for (std::uint64_t& o : out) o = ~std::uint64_t{0};
+            return;
+        }
+
+        if ((n & (n - 1)) == 0 && std::countr_zero(n) <= detail::pow2_mask_max_k)
+        {
+            const int k = std::countr_zero(n);
+            for (std::uint64_t& o : out) o = detail::pow2_mask(rng, k);
+            return;
+        }
+
+        const std::uint64_t lead = detail::recip_lead(n);
+        const std::uint64_t rem = std::uint64_t{0} - lead * n;
+        for (std::uint64_t& o : out) o = detail::recip_mask(rng, n, lead, rem);
+    }
+
+    // ----------------------------
+    // Constexpr elementary functions
+    // ----------------------------
+    // exp / log / sqrt / floor usable in constant expressions, accurate to a
+    // few ulp and independent of the platform libm (geometric skip, binomial,
+    // ziggurat).
+    // Each multiply and add rounds separately. Constant evaluation never
+    // fuses them; at run time that needs -ffp-contract=off on GCC (see the
+    // uniform real section), since an FMA would change the rounding.
+    namespace detail
+    {
+        [[nodiscard]] constexpr double cx_pow2i(int k) noexcept
+        {
+            return std::bit_cast<double>(static_cast<std::uint64_t>(k + 1023) << 52); // k in [-1022, 1023]
+        }
+
+        inline constexpr double cx_ln2_hi = 0x1.62e42fefa3800p-1;
+        inline constexpr double cx_ln2_lo = 0x1.ef35793c7673p-45;
+
+        // 1/n! for the exp series (divisions done once, at compile time).
+        inline constexpr std::array<double, 16> cx_exp_coef = []
+        {
+            std::array<double, 16> c{};
+            double f = 1.0;
+            for (std::size_t n = 0; n < c.size(); ++n)
+            {
+                c[n] = f;
+                f = f / static_cast<double>(n + 1);
+            }
+            return c;
+        }();
+
+        // exp(x) for |x| < 700.
+        [[nodiscard]] constexpr double cx_exp(double x) noexcept
+        {
+            const double kf = x * 0x1.71547652b82fep0; // x / ln 2
+            const int k = static_cast<int>(kf < 0 ? kf - 0.5 : kf + 0.5);
+            const double kh = static_cast<double>(k) * cx_ln2_hi;
+            const double kl = static_cast<double>(k) * cx_ln2_lo;
+            const double r = (x - kh) - kl; // |r| <= ln2 / 2
+
+            // Taylor to r^15 / 15!: below 2^-60 for |r| <= 0.35.
+            double p = cx_exp_coef[15];
+            for (std::size_t n = 15; n-- > 0;)
+            {
+                p = p * r;
+                p = p + cx_exp_coef[n];
+            }
+            return p * cx_pow2i(k);
+        }
+
+        // log(x) for normal x > 0.
+        [[nodiscard]] constexpr double cx_log(double x) noexcept
+        {
+            const std::uint64_t bits = std::bit_cast<std::uint64_t>(x);
+            int e = static_cast<int>((bits >> 52) & 0x7FF) - 1023;
+            double m = std::bit_cast<double>((bits & 0x000F'FFFF'FFFF'FFFFULL) | 0x3FF0'0000'0000'0000ULL);
+            if (m > 0x1.6a09e667f3bcdp0) // sqrt(2)
+            {
+                m = m * 0.5;
+                ++e;
+            }
+
+            // log(m) = 2 atanh(y) = 2 (y + y^3/3 + y^5/5 + ...), |y| <= 0.172:
+            // 12 terms reach y^23 < 2^-58.
+            const double y = (m - 1.0) / (m + 1.0);
+            const double y2 = y * y;
+            double p = 1.0 / 23.0;
+            for (int k = 21; k >= 1; k -= 2)
+            {
+                p = p * y2;
+                p = p + 1.0 / k;
+            }
+            const double sum = y * p;
+            const double eh = static_cast<double>(e) * cx_ln2_hi;
+            const double el = static_cast<double>(e) * cx_ln2_lo;
+            const double lm = 2.0 * sum;
+            return eh + (lm + el);
+        }
+
+        [[nodiscard]] constexpr double cx_sqrt(double x) noexcept
+        {
+            if (!(x > 0.0)) return 0.0;
+            double g = std::bit_cast<double>((std::bit_cast<std::uint64_t>(x) >> 1) + 0x1FF8'0000'0000'0000ULL);
+            for (int i = 0; i < 8; ++i)
+                g = 0.5 * (g + x / g);
+            return g;
+        }
+
+        // |x| >= 2^52 (and inf / NaN) is already integral.
+        [[nodiscard]] constexpr double cx_floor(double x) noexcept
+        {
+            if (!(x > -0x1.0p52 && x < 0x1.0p52)) return x;
+            const double t = static_cast<double>(static_cast<std::int64_t>(x));
+            return t > x ? t - 1.0 : t;
+        }
+
+        [[nodiscard]] constexpr double cx_fabs(double x) noexcept
+        {
+            return x < 0.0 ? -x : x;
+        }
+    } // namespace detail
+
+    // ----------------------------
+    // Geometric skip-ahead: failures before the next "1 in N" hit
+    // ----------------------------
+    // For a run of independent 1/N trials, the gap to the next hit is
+    // Geometric(1/N) and can be drawn directly: floor(log(U) / log(1 - 1/N))
+    // with U uniform in (0, 1]. One draw and one log per hit instead of ~N
+    // draws. Accurate to double precision: U has 53 bits, so gaps with
+    // probability below ~2^-53 are not produced. The log is cx_log, so gaps
+    // are the same in constant expressions and with any libm.
+    namespace detail
+    {
+        // Uniform double in (0, 1] from the top 53 bits; never 0, so log() is finite.
+        [[nodiscard]] constexpr double unit_open_closed(std::uint64_t x) noexcept
+        {
+            return static_cast<double>((x >> 11) + 1) * 0x1.0p-53;
+        }
+
+        // log(1 - x) for 0 < x <= 1/2, usable in constant expressions:
+        // log(1 - x) = -2 atanh(y) with y = x / (2 - x) <= 1/3.
+        [[nodiscard]] constexpr double log1m(double x) noexcept
+        {
+            const double y = x / (2.0 - x);
+            const double y2 = y * y;
+            double sum = 0.0;
+            double pw = y;
+            for (int k = 1; k < 100; k += 2)
+            {
+                const double term = pw / k;
+                sum += term;
+                if (term < sum * 0x1.0p-60) break;
+                pw *= y2;
+            }
+            return -2.0 * sum;
+        }
+    } // namespace detail
+
+    class geometric_skip final
+    {
+    public:
+        constexpr geometric_skip() noexcept = default;
+
+        constexpr explicit geometric_skip(std::uint64_t bound) noexcept
+            : bound_(bound),
+              inv_log_q_(bound <= 1 ? 0.0 : 1.0 / detail::log1m(1.0 / static_cast<double>(bound)))
+        {
+        }
+
+        [[nodiscard]] constexpr std::uint64_t bound() const noexcept { return bound_; }
+
+        // Number of misses before the next hit (0 means the next trial hits).
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr std::uint64_t operator()(Rng& rng) const noexcept
+        {
+            if (bound_ <= 1) return 0;
+
+            // log(U) * inv_log_q_ >= 0; truncation is floor.
+            AYEJAY_ODDS_STAT_DRAWS(1);
+            const double k = detail::cx_log(detail::unit_open_closed(rng.next_u64())) * inv_log_q_;
+            if (!(k < 0x1.0p64)) return std::numeric_limits<std::uint64_t>::max();
+            return static_cast<std::uint64_t>(k);
+        }
+
+        // Calls f(index) for every hit among trials [0, trials).
+        template <uniform_random_bit_engine Rng, class F>
+        constexpr void for_each_hit(Rng& rng, std::uint64_t trials, F&& f) const
+        {
+            std::uint64_t i = 0;
+            for (;;)
+            {
+                const std::uint64_t gap = (*this)(rng);
+                if (gap >= trials - i) return;
+                i += gap;
+                f(i);
+                if (++i == trials) return;
+            }
+        }
+
+    private:
+        std::uint64_t bound_ = 1;
+        double inv_log_q_ = 0.0;
+    };
+
+    template <unsigned_int UInt = std::uint32_t, uniform_random_bit_engine Rng = xoshiro256ss>
+    [[nodiscard]] constexpr std::uint64_t next_hit(Rng& rng, UInt bound) noexcept
+    {
+        return geometric_skip(static_cast<std::uint64_t>(bound))(rng);
+    }
+
+    template <unsigned_int UInt = std::uint32_t, uniform_random_bit_engine Rng = xoshiro256ss, class F>
+    constexpr void for_each_hit(Rng& rng, UInt bound, std::uint64_t trials, F&& f)
+    {
+        geometric_skip(static_cast<std::uint64_t>(bound)).for_each_hit(rng, trials, static_cast<F&&>(f));
+    }
+
+    // ----------------------------
+    // Binomial counts: how many of `trials` independent trials hit
+    // ----------------------------
+    // binomial(rng, trials, p) samples the count directly:
+    // - mean min(p, 1-p) * trials < 30: inversion (one draw, O(mean) steps);
+    // - otherwise BTPE (Kachitvichyanukul & Schmeiser 1988), O(1) expected.
+    // Both are exact rejection/inversion methods; accuracy is that of their
+    // double-precision evaluation (trials should stay below 2^53). The math
+    // is the constexpr cx_* set above, so counts are the same in constant
+    // expressions and with any libm (given no FMA contraction, see the
+    // uniform real section).
+    //
+    // binomial_count(rng, trials, N) is the 1/N case. For trials <= 256 it
+    // sums bit-sliced one_in_mask words instead, which is exact outright.
+    namespace detail
+    {
+        // Uniform double in [0, 1) from the top 53 bits.
+        [[nodiscard]] constexpr double unit_closed_open(std::uint64_t x) noexcept
+        {
+            return static_cast<double>(x >> 11) * 0x1.0p-53;
+        }
+
+        // p <= 1/2, n * p < 30.
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr std::uint64_t binomial_inversion(Rng& rng, std::uint64_t trials, double p) noexcept
+        {
+            const double n = static_cast<double>(trials);
+            const double q = 1.0 - p;
+            const double qn = cx_exp(n * log1m(p)); // n log(1 - p) > -42 here
+            const double np = n * p;
+            const double spread = np + 10.0 * cx_sqrt(np * q + 1.0);
+            const double bound = n < spread ? n : spread;
+
+            std::uint64_t x = 0;
+            double px = qn;
+            AYEJAY_ODDS_STAT_DRAWS(1);
+            double u = unit_closed_open(rng.next_u64());
+            while (u > px)
+            {
+                ++x;
+                if (static_cast<double>(x) > bound)
+                {
+                    x = 0;
+                    px = qn;
+                    AYEJAY_ODDS_STAT_DRAWS(1);
+                    u = unit_closed_open(rng.next_u64());
+                }
+                else
+                {
+                    u -= px;
+                    const double xd = static_cast<double>(x);
+                    px = ((n - xd + 1.0) * p * px) / (xd * q);
+                }
+            }
+            return x;
+        }
+
+        // p <= 1/2, n * p >= 30.
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr std::uint64_t binomial_btpe(Rng& rng, std::uint64_t trials, double p) noexcept
+        {
+            const double n = static_cast<double>(trials);
+            const double r = p;
+            const double q = 1.0 - r;
+            const double fm = n * r + r;
+            const double m = cx_floor(fm);
+            const double nrq = n * r * q;
+
+            const double p1 = cx_floor(2.195 * cx_sqrt(nrq) - 4.6 * q) + 0.5;
+            const double xm = m + 0.5;
+            const double xl = xm - p1;
+            const double xr = xm + p1;
+            const double c = 0.134 + 20.5 / (15.3 + m);
+
+            double a = (fm - xl) / (fm - xl * r);
+            const double laml = a * (1.0 + a / 2.0);
+            a = (xr - fm) / (xr * q);
+            const double lamr = a * (1.0 + a / 2.0);
+
+            const double p2 = p1 * (1.0 + 2.0 * c);
+            const double p3 = p2 + c / laml;
+            const double p4 = p3 + c / lamr;
+
+            for (;;)
+            {
+                AYEJAY_ODDS_STAT_DRAWS(2);
+                const double u = unit_closed_open(rng.next_u64()) * p4;
+                double v = unit_closed_open(rng.next_u64());
+                double y = 0.0;
+
+                if (u <= p1)
+                {
+                    // Triangular centre: accept immediately.
+                    return static_cast<std::uint64_t>(cx_floor(xm - p1 * v + u));
+                }
+
+                if (u <= p2)
+                {
+                    // Parallelograms.
+                    const double x = xl + (u - p1) / c;
+                    v = v * c + 1.0 - cx_fabs(m - x + 0.5) / p1;
+                    if (v > 1.0) continue;
+                    y = cx_floor(x);
+                }
+                else if (u <= p3)
+                {
+                    // Left exponential tail.
+                    if (v == 0.0) continue;
+                    y = cx_floor(xl + cx_log(v) / laml);
+                    if (y < 0.0) continue;
+                    v = v * (u - p2) * laml;
+                }
+                else
+                {
+                    // Right exponential tail.
+                    if (v == 0.0) continue;
+                    y = cx_floor(xr - cx_log(v) / lamr);
+                    if (y > n) continue;
+                    v = v * (u - p3) * lamr;
+                }
+
+                const double k = cx_fabs(y - m);
+                if (k <= 20.0 || k >= nrq / 2.0 - 1.0)
+                {
+                    // Explicit evaluation of f(y) / f(m).
+                    const double s = r / q;
+                    const double aa = s * (n + 1.0);
+                    double f = 1.0;
+                    if (m < y)
+                        for (double i = m + 1.0; i <= y; i += 1.0) f *= (aa / i - s);
+                    else if (m > y)
+                        for (double i = y + 1.0; i <= m; i += 1.0) f /= (aa / i - s);
+                    if (v > f) continue;
+                    return static_cast<std::uint64_t>(y);
+                }
+
+                // Squeeze using upper and lower bounds on log(f(y)). A
+                // parallelogram v <= 0 is below any f(y) / f(m) > 0.
+                if (!(v > 0.0)) return static_cast<std::uint64_t>(y);
+                const double rho = (k / nrq) * ((k * (k / 3.0 + 0.625) + 0.1666666666666) / nrq + 0.5);
+                const double t = -k * k / (2.0 * nrq);
+                const double av = cx_log(v);
+                if (av < t - rho) return static_cast<std::uint64_t>(y);
+                if (av > t + rho) continue;
+
+                // Final test with Stirling corrections.
+                const double x1 = y + 1.0;
+                const double f1 = m + 1.0;
+                const double z = n + 1.0 - m;
+                const double w = n - y + 1.0;
+                const double x2 = x1 * x1;
+                const double f2 = f1 * f1;
+                const double z2 = z * z;
+                const double w2 = w * w;
+
+                const double bound =
+                    xm * cx_log(f1 / x1) + (n - m + 0.5) * cx_log(z / w) + (y - m) * cx_log(w * r / (x1 * q))
+                    + (13680. - (462. - (132. - (99. - 140. / f2) / f2) / f2) / f2) / f1 / 166320.
+                    + (13680. - (462. - (132. - (99. - 140. / z2) / z2) / z2) / z2) / z / 166320.
+                    + (13680. - (462. - (132. - (99. - 140. / x2) / x2) / x2) / x2) / x1 / 166320.
+                    + (13680. - (462. - (132. - (99. - 140. / w2) / w2) / w2) / w2) / w / 166320.;
+                if (av > bound) continue;
+                return static_cast<std::uint64_t>(y);
+            }
+        }
+    } // namespace detail
+
+    template <uniform_random_bit_engine Rng>
+    [[nodiscard]] constexpr std::uint64_t binomial(Rng& rng, std::uint64_t trials, double p) noexcept
+    {
+        if (trials == 0 || !(p > 0.0)) return 0;
+        if (p >= 1.0) return trials;
+
+        const bool flip = p > 0.5;
+        const double r = flip ? 1.0 - p : p;
+        const std::uint64_t k = (static_cast<double>(trials) * r < 30.0)
+            ? detail::binomial_inversion(rng, trials, r)
+            : detail::binomial_btpe(rng, trials, r);
+        return flip ? trials - k : k;
+    }
+
+    template <unsigned_int UInt = std::uint32_t, uniform_random_bit_engine Rng = xoshiro256ss>
+    [[nodiscard]] constexpr std::uint64_t binomial_count(Rng& rng, std::uint64_t trials, UInt bound) noexcept
+    {
+        if (bound <= 1) return trials;
+
+        if (trials <= 256)
+        {
+            std::uint64_t hits = 0;
+            for (std::uint64_t done = 0; done < trials; done += 64)
+            {
+                std::uint64_t m = one_in_mask(rng, bound);
+                if (trials - done < 64)
+                    m &= (std::uint64_t{1} << (trials - done)) - 1ULL;
+                hits += static_cast<std::uint64_t>(std::popcount(m));
+            }
+            return hits;
+        }
+
+        return binomial(rng, trials, 1.0 / static_cast<double>(bound));
+    }
+
+    // ----------------------------
+    // Ziggurat normal / exponential (Marsaglia & Tsang, 256 layers)
+    // ----------------------------
+    // One draw picks a layer (8 bits) and a position in it; 98.5% of normal
+    // and 97.8% of exponential samples (the mean of k[i] over the tables)
+    // return after one multiply and one compare. Tables are generated at
+    // compile time. The rare wedge/tail paths use the constexpr exp/log above
+    // instead of <cmath>, so results do not depend on the platform libm.
+    namespace detail
+    {
+        // Layer i: accept outright when the raw value is below k[i]; the
+        // sample is raw * w[i]; f[i] is the density at the layer's edge.
+        struct ziggurat_table final
+        {
+            std::array<std::uint64_t, 256> k{};
+            std::array<double, 256> w{};
+            std::array<double, 256> f{};
+        };
+
+        inline constexpr double normal_zig_r = 3.6541528853610088;
+        inline constexpr double normal_zig_v = 0.00492867323399;
+        inline constexpr double exponential_zig_r = 7.69711747013104972;
+        inline constexpr double exponential_zig_v = 0.0039496598225815571993;
+
+        // 52-bit magnitudes (the draw also carries 8 layer bits and a sign).
+        inline constexpr ziggurat_table normal_zig = []
+        {
+            constexpr double m = 0x1.0p52;
+            ziggurat_table t;
+            double dn = normal_zig_r;
+            double tn = dn;
+            const double q = normal_zig_v / cx_exp(-0.5 * dn * dn);
+
+            t.k[0] = static_cast<std::uint64_t>((dn / q) * m);
+            t.k[1] = 0;
+            t.w[0] = q / m;
+            t.w[255] = dn / m;
+            t.f[0] = 1.0;
+            t.f[255] = cx_exp(-0.5 * dn * dn);
+            for (int i = 254; i >= 1; --i)
+            {
+                dn = cx_sqrt(-2.0 * cx_log(normal_zig_v / dn + cx_exp(-0.5 * dn * dn)));
+                t.k[static_cast<std::size_t>(i + 1)] = static_cast<std::uint64_t>((dn / tn) * m);
+                tn = dn;
+                t.f[static_cast<std::size_t>(i)] = cx_exp(-0.5 * dn * dn);
+                t.w[static_cast<std::size_t>(i)] = dn / m;
+            }
+            return t;
+        }();
+
+        // 53-bit magnitudes (8 layer bits, 3 bits unused).
+        inline constexpr ziggurat_table exponential_zig = []
+        {
+            constexpr double m = 0x1.0p53;
+            ziggurat_table t;
+            double de = exponential_zig_r;
+            double te = de;
+            const double q = exponential_zig_v / cx_exp(-de);
+
+            t.k[0] = static_cast<std::uint64_t>((de / q) * m);
+            t.k[1] = 0;
+            t.w[0] = q / m;
+            t.w[255] = de / m;
+            t.f[0] = 1.0;
+            t.f[255] = cx_exp(-de);
+            for (int i = 254; i >= 1; --i)
+            {
+                de = -cx_log(exponential_zig_v / de + cx_exp(-de));
+                t.k[static_cast<std::size_t>(i + 1)] = static_cast<std::uint64_t>((de / te) * m);
+                te = de;
+                t.f[static_cast<std::size_t>(i)] = cx_exp(-de);
+                t.w[static_cast<std::size_t>(i)] = de / m;
+            }
+            return t;
+        }();
+
+        // y = f[i] + (f[i-1] - f[i]) * u: a uniform height inside layer i.
+        [[nodiscard]] constexpr double ziggurat_height(const ziggurat_table& t, std::size_t i, double u) noexcept
+        {
+            const double scaled = (t.f[i - 1] - t.f[i]) * u;
+            return t.f[i] + scaled;
+        }
+
+        // One layer draw from the raw word r: the sample, and whether it is
+        // inside the layer's rectangle (accepted without further work).
+        [[nodiscard]] constexpr bool normal_layer(std::uint64_t r, double& x) noexcept
+        {
+            const ziggurat_table& t = normal_zig;
+            const std::size_t i = static_cast<std::size_t>(r & 0xFF);
+            const std::uint64_t sign = (r & 0x100ULL) << 55; // bit 8 -> IEEE sign bit
+            const std::uint64_t mag = (r >> 9) & 0x000F'FFFF'FFFF'FFFFULL;
+
+            // Sign applied by bit flip: a branch here mispredicts half the time.
+            x = std::bit_cast<double>(
+                std::bit_cast<std::uint64_t>(static_cast<double>(static_cast<std::int64_t>(mag)) * t.w[i]) ^ sign);
+            return mag < t.k[i];
+        }
+
+        // Wedge and tail handling after normal_layer(r) rejected; redraws
+        // until a sample is accepted. Kept out of the hot path so it does not
+        // cost registers there.
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr double normal_slow(Rng& rng, std::uint64_t r, double x) noexcept
+        {
+            const ziggurat_table& t = normal_zig;
+            for (;;)
+            {
+                const std::size_t i = static_cast<std::size_t>(r & 0xFF);
+                if (i == 0)
+                {
+                    // Tail beyond R: x = -log(U1) / R, y = -log(U2), accept if 2y > x^2.
+                    for (;;)
+                    {
+                        AYEJAY_ODDS_STAT_DRAWS(2);
+                        const double xx = -cx_log(unit_open_closed(rng.next_u64())) / normal_zig_r;
+                        const double yy = -cx_log(unit_open_closed(rng.next_u64()));
+                        if (yy + yy > xx * xx)
+                            return (r & 0x100ULL) != 0 ? -(normal_zig_r + xx) : normal_zig_r + xx;
+                    }
+                }
+
+                AYEJAY_ODDS_STAT_DRAWS(1);
+                if (ziggurat_height(t, i, unit_closed_open(rng.next_u64())) < cx_exp(-0.5 * x * x))
+                    return x;
+
+                AYEJAY_ODDS_STAT_DRAWS(1);
+                r = rng.next_u64();
+                if (normal_layer(r, x)) return x;
+            }
+        }
+
+        // Standard normal starting from the raw word r.
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr double normal_from(Rng& rng, std::uint64_t r) noexcept
+        {
+            double x = 0.0;
+            if (normal_layer(r, x)) return x;
+            return normal_slow(rng, r, x);
+        }
+
+        [[nodiscard]] constexpr bool exponential_layer(std::uint64_t r, double& x) noexcept
+        {
+            const ziggurat_table& t = exponential_zig;
+            const std::size_t i = static_cast<std::size_t>((r >> 3) & 0xFF);
+            const std::uint64_t mag = r >> 11;
+
+            x = static_cast<double>(static_cast<std::int64_t>(mag)) * t.w[i];
+            return mag < t.k[i];
+        }
+
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr double exponential_slow(Rng& rng, std::uint64_t r, double x) noexcept
+        {
+            const ziggurat_table& t = exponential_zig;
+            for (;;)
+            {
+                const std::size_t i = static_cast<std::size_t>((r >> 3) & 0xFF);
+
+                // Memoryless tail: R plus a fresh Exp(1).
+                AYEJAY_ODDS_STAT_DRAWS(1);
+                if (i == 0)
+                    return exponential_zig_r - cx_log(unit_open_closed(rng.next_u64()));
+
+                if (ziggurat_height(t, i, unit_closed_open(rng.next_u64())) < cx_exp(-x))
+                    return x;
+
+                AYEJAY_ODDS_STAT_DRAWS(1);
+                r = rng.next_u64();
+                if (exponential_layer(r, x)) return x;
+            }
+        }
+
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr double exponential_from(Rng& rng, std::uint64_t r) noexcept
+        {
+            double x = 0.0;
+            if (exponential_layer(r, x)) return x;
+            return exponential_slow(rng, r, x);
+        }
+    } // namespace detail
+
+    // Standard normal N(0, 1).
+    template <uniform_random_bit_engine Rng>
+    [[nodiscard]] constexpr double normal(Rng& rng) noexcept
+    {
+        AYEJAY_ODDS_STAT_DRAWS(1);
+        return detail::normal_from(rng, rng.next_u64());
+    }
+
+    // N(mean, sd^2).
+    template <uniform_random_bit_engine Rng>
+    [[nodiscard]] constexpr double normal(Rng& rng, double mean, double sd) noexcept
+    {
+        const double scaled = sd * normal(rng);
+        return mean + scaled;
+    }
+
+    // Exponential with rate 1 (mean 1).
+    template <uniform_random_bit_engine Rng>
+    [[nodiscard]] constexpr double exponential(Rng& rng) noexcept
+    {
+        AYEJAY_ODDS_STAT_DRAWS(1);
+        return detail::exponential_from(rng, rng.next_u64());
+    }
+
+    // Exponential with the given rate (mean 1 / rate), e.g. spawn timers.
+    template <uniform_random_bit_engine Rng>
+    [[nodiscard]] constexpr double exponential(Rng& rng, double rate) noexcept
+    {
+        return exponential(rng) / rate;
+    }
+
+    [[nodiscard]] inline double normal() noexcept { return normal(thread_rng()); }
+    [[nodiscard]] inline double normal(double mean, double sd) noexcept { return normal(thread_rng(), mean, sd); }
+    [[nodiscard]] inline double exponential() noexcept { return exponential(thread_rng()); }
+    [[nodiscard]] inline double exponential(double rate) noexcept { return exponential(thread_rng(), rate); }
+
+    // Batch forms: first words come in blocks, the rare retries from rng
+    // directly, so the sequence differs from repeated scalar calls (the
+    // distribution is the same).
+    template <uniform_random_bit_engine Rng>
+    constexpr void normal_fill(Rng& rng, std::span<double> out) noexcept
+    {
+        detail::for_each_word(rng, out.size(),
+            [&rng, out](std::size_t i, std::uint64_t r) noexcept { out[i] = detail::normal_from(rng, r); });
+    }
+
+    template <uniform_random_bit_engine Rng>
+    constexpr void normal_fill(Rng& rng, std::span<double> out, double mean, double sd) noexcept
+    {
+        detail::for_each_word(rng, out.size(),
+            [&rng, out, mean, sd](std::size_t i, std::uint64_t r) noexcept
+            {
+                const double scaled = sd * detail::normal_from(rng, r);
+                out[i] = mean + scaled;
+            });
+    }
+
+    template <uniform_random_bit_engine Rng>
+    constexpr void exponential_fill(Rng& rng, std::span<double> out) noexcept
+    {
+        detail::for_each_word(rng, out.size(),
+            [&rng, out](std::size_t i, std::uint64_t r) noexcept { out[i] = detail::exponential_from(rng, r); });
+    }
+
+    // ----------------------------
+    // Compile-time/cached odds: one_in<N>()
+    // ----------------------------
+    // Decides "draw == 0" by comparing the raw word against compile-time
+    // constants: no multiply, no runtime division. Words are split into
+    // [0, hit_below) -> hit, [hit_below, accept_below) -> miss, and the
+    // remainder (fewer than N words out of 2^64) is redrawn, so the hit
+    // probability is exactly 1/N.
+    template <std::uint32_t N>
+    struct one_in_t final
+    {
+        static_assert(N >= 1, "one_in_t<N>: N must be >= 1");
+
+        static constexpr bool is_pow2 = (N & (N - 1)) == 0;
+
+        // floor(2^64 / N); unused for N == 1.
+        static constexpr std::uint64_t hit_below = (N == 1) ? 0 : detail::recip_lead(N);
+
+        // N * floor(2^64 / N): the largest multiple of N not above 2^64.
+        // Wraps to 0 for powers of two, where nothing is rejected.
+        static constexpr std::uint64_t accept_below = hit_below * N;
+
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr bool operator()(Rng& rng) const noexcept
+        {
+            if constexpr (N == 1)
+            {
+                return true;
+            }
+            else if constexpr (is_pow2)
+            {
+                static_assert(accept_below == 0, "one_in_t<N>: power-of-two N must not reject");
+                static_assert(hit_below == (std::uint64_t{1} << (64 - std::countr_zero(N))),
+                              "one_in_t<N>: power-of-two N must hit on the top log2(N) bits being zero");
+                AYEJAY_ODDS_STAT_CONST_CALLS(N, 1);
+                return rng.next_u64() < hit_below;
+            }
+            else
+            {
+                AYEJAY_ODDS_STAT_CONST_CALLS(N, 1);
+                // The accept test is almost always true, so it predicts
+                // well; the hit itself is a compare, not a branch.
+                for (;;)
+                {
+                    const std::uint64_t x = rng.next_u64();
+                    if (x < accept_below) [[likely]] return x < hit_below;
+                    AYEJAY_ODDS_STAT_REJECTION();
+                }
+            }
+        }
+
+        [[nodiscard]] inline bool operator()() const noexcept
+        {
+            return (*this)(thread_rng());
+        }
+
+        // 64 independent trials, one per bit (see one_in_mask).
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr std::uint64_t mask(Rng& rng) const noexcept
+        {
+            if constexpr (N == 1)
+                return ~std::uint64_t{0};
+            else if constexpr (is_pow2 && std::countr_zero(N) <= detail::pow2_mask_max_k)
+                return detail::pow2_mask(rng, std::countr_zero(N));
+            else
+                return detail::recip_mask(rng, N, hit_below, std::uint64_t{0} - accept_below);
+        }
+
+        template <uniform_random_bit_engine Rng>
+        constexpr void fill_bits(Rng& rng, std::span<std::uint64_t> out) const noexcept
+        {
+            for (std::uint64_t& o : out) o = mask(rng);
+        }
+
+        // Misses before the next hit (see geometric_skip); the log constant is compile-time.
+        static constexpr geometric_skip skip{ N };
+
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr std::uint64_t next_hit(Rng& rng) const noexcept
+        {
+            return skip(rng);
+        }
+    };
+
+    template <std::uint32_t N>
+    inline constexpr one_in_t<N> one_in_v{};
+
+    // Compile-time M in N, exact, compare-only (same split as one_in_t:
+    // hit below M*floor(2^64/N), redraw at or above N*floor(2^64/N)).
+    template <std::uint32_t M, std::uint32_t N>
+    struct m_in_n_t final
+    {
+        static_assert(N >= 1, "m_in_n_t<M, N>: N must be >= 1");
+        static_assert(M <= N, "m_in_n_t<M, N>: M must be <= N");
+
+        static constexpr std::uint64_t hit_below = (M == N) ? 0 : std::uint64_t{M} * one_in_t<N>::hit_below;
+        static constexpr std::uint64_t accept_below = one_in_t<N>::accept_below;
+
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr bool operator()(Rng& rng) const noexcept
+        {
+            if constexpr (M == N)
+            {
+                return true;
+            }
+            else if constexpr (M == 0)
+            {
+                return false;
+            }
+            else
+            {
+                AYEJAY_ODDS_STAT_CONST_CALLS(N, 1);
+                for (;;)
+                {
+                    const std::uint64_t x = rng.next_u64();
+                    if constexpr (one_in_t<N>::is_pow2)
+                        return x < hit_below;
+                    else if (x < accept_below) [[likely]]
+                        return x < hit_below;
+                    AYEJAY_ODDS_STAT_REJECTION();
+                }
+            }
+        }
+
+        [[nodiscard]] inline bool operator()() const noexcept
+        {
+            return (*this)(thread_rng());
+        }
+    };
+
+    template <std::uint32_t M, std::uint32_t N>
+    inline constexpr m_in_n_t<M, N> m_in_n_v{};
+
+    // Compile-time fixed-point chance: chance_v<probability::percent(0.35)>.
+    template <probability P>
+    struct chance_t final
+    {
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr bool operator()(Rng& rng) const noexcept
+        {
+            if constexpr (P.certain)
+                return true;
+            else if constexpr (P.threshold == 0)
+                return false;
+            else
+            {
+                AYEJAY_ODDS_STAT_DRAWS(1);
+                return rng.next_u64() < P.threshold;
+            }
+        }
+
+        [[nodiscard]] inline bool operator()() const noexcept
+        {
+            return (*this)(thread_rng());
+        }
+    };
+
+    template <probability P>
+    inline constexpr chance_t<P> chance_v{};
+
+    // ----------------------------
+    // Presets / common denominators
+    // ----------------------------
+    // Requested:
+    // 2, 5, 10, 25, 50, 100
+    //
+    // Additional common gameplay denominators:
+    // 3, 4, 6, 8, 12, 16, 20, 30, 60, 128, 256
+    inline constexpr one_in_t<2>   p2{};
+    inline constexpr one_in_t<3>   p3{};
+    inline constexpr one_in_t<4>   p4{};
+    inline constexpr one_in_t<5>   p5{};
+    inline constexpr one_in_t<6>   p6{};
+    inline constexpr one_in_t<8>   p8{};
+    inline constexpr one_in_t<10>  p10{};
+    inline constexpr one_in_t<12>  p12{};
+    inline constexpr one_in_t<16>  p16{};
+    inline constexpr one_in_t<20>  p20{};
+    inline constexpr one_in_t<25>  p25{};
+    inline constexpr one_in_t<30>  p30{};
+    inline constexpr one_in_t<50>  p50{};
+    inline constexpr one_in_t<60>  p60{};
+    inline constexpr one_in_t<100> p100{};
+    inline constexpr one_in_t<128> p128{};
+    inline constexpr one_in_t<256> p256{};
+
+    // Convenience named wrappers.
+    [[nodiscard]] inline bool one_in_2()   noexcept { return p2(); }
+    [[nodiscard]] inline bool one_in_5()   noexcept { return p5(); }
+    [[nodiscard]] inline bool one_in_10()  noexcept { return p10(); }
+    [[nodiscard]] inline bool one_in_25()  noexcept { return p25(); }
+    [[nodiscard]] inline bool one_in_50()  noexcept { return p50(); }
+    [[nodiscard]] inline bool one_in_100() noexcept { return p100(); }
+
+    // ----------------------------
+    // weighted_table - Walker/Vose alias method
+    // ----------------------------
+    // O(n) build, O(1) draw: one bounded index plus one 64-bit coin compare.
+    // Column i keeps index i with probability keep[i] / 2^64, otherwise it
+    // yields alias[i]. Both arrays are stored contiguously (SoA). Full
+    // columns alias to themselves, so the fixed-point coin adds no bias there;
+    // elsewhere each column's split is rounded to 2^-64.
+    class weighted_table final
+    {
+    public:
+        weighted_table() = default;
+
+        // Negative and NaN weights count as 0. If every weight is 0 the
+        // table is uniform. Precondition for drawing: !weights.empty().
+        explicit weighted_table(std::span<const double> weights)
+        {
+            build(weights);
+        }
+
+        weighted_table(std::initializer_list<double> weights)
+        {
+            build(std::span<const double>(weights.begin(), weights.size()));
+        }
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return keep_.size(); }
+
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr std::uint32_t operator()(Rng& rng) const noexcept
+        {
+            const std::uint32_t i = index_(rng);
+            AYEJAY_ODDS_STAT_DRAWS(1);
+            return (rng.next_u64() < keep_[i]) ? i : alias_[i];
+        }
+
+        // Batch draw: all column indices first, then coins in blocks.
+        template <uniform_random_bit_engine Rng>
+        constexpr void fill(Rng& rng, std::span<std::uint32_t> out) const noexcept
+        {
+            index_.fill(rng, out);
+
+            constexpr std::size_t block = 64;
+            std::array<std::uint64_t, block> coins{};
+            for (std::size_t base = 0; base < out.size(); base += block)
+            {
+                const std::size_t n = (out.size() - base < block) ? (out.size() - base) : block;
+                const std::span<std::uint64_t> words(coins.data(), n);
+                if constexpr (requires { rng.fill(words); })
+                    rng.fill(words);
+                else
+                    for (std::uint64_t& w : words) w = rng.next_u64();
+                AYEJAY_ODDS_STAT_DRAWS(n);
+
+                for (std::size_t k = 0; k < n; ++k)
+                {
+                    const std::uint32_t i = out[base + k];
+                    out[base + k] = (coins[k] < keep_[i]) ? i : alias_[i];
+                }
+            }
+        }
+
+        [[nodiscard]] constexpr std::span<const std::uint64_t> keep_thresholds() const noexcept { return keep_; }
+        [[nodiscard]] constexpr std::span<const std::uint32_t> aliases() const noexcept { return alias_; }
+
+    private:
+        // O(n) Vose build (src/weighted_table.cpp).
+        void build(std::span<const double> weights);
+
+        std::vector<std::uint64_t> keep_;
+        std::vector<std::uint32_t> alias_;
+        bounded_sampler<std::uint32_t> index_;
+    };
+
+    // ----------------------------
+    // dynamic_weighted_table - weights that change every tick
+    // ----------------------------
+    // Integer weights in an implicit Fenwick tree (one flat array, no
+    // pointers): O(log n) update(i, w), O(log n) draw, no allocation after
+    // construction. A draw is one uniform_bounded<std::uint64_t>(total) plus
+    // a top-down descent, so it is exact. Precondition: total() fits in 64
+    // bits and is non-zero when drawing.
+    class dynamic_weighted_table final
+    {
+    public:
+        dynamic_weighted_table() = default;
+
+        // n entries, all weight 0.
+        constexpr explicit dynamic_weighted_table(std::size_t n)
+            : weights_(n, 0), tree_(n + 1, 0), top_(n == 0 ? 0 : std::bit_floor(n))
+        {
+        }
+
+        // O(n) build (src/weighted_table.cpp).
+        explicit dynamic_weighted_table(std::span<const std::uint64_t> weights);
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return weights_.size(); }
+        [[nodiscard]] constexpr std::uint64_t total() const noexcept { return total_; }
+        [[nodiscard]] constexpr std::uint64_t weight(std::size_t i) const noexcept { return weights_[i]; }
+
+        // Set entry i to weight w. O(log n).
+        constexpr void update(std::size_t i, std::uint64_t w) noexcept
+        {
+            const std::uint64_t delta = w - weights_[i]; // wraps for decreases; sums stay exact
+            weights_[i] = w;
+            total_ += delta;
+            for (std::size_t k = i + 1; k < tree_.size(); k += k & (~k + 1))
+                tree_[k] += delta;
+        }
+
+        template <uniform_random_bit_engine Rng>
+        [[nodiscard]] constexpr std::uint32_t operator()(Rng& rng) const noexcept
+        {
+            return find(uniform_bounded<std::uint64_t>(rng, total_));
+        }
+
+        // Batch draw: the bound (total) is prepared once for the whole batch.
+        template <uniform_random_bit_engine Rng>
+        constexpr void fill(Rng& rng, std::span<std::uint32_t> out) const noexcept
+        {
+            const bounded_sampler<std::uint64_t> pick(total_);
+            for (std::uint32_t& o : out)
+                o = find(pick(rng));
+        }
+
+        // Entry whose cumulative weight range contains r (r < total()).
+        [[nodiscard]] constexpr std::uint32_t find(std::uint64_t r) const noexcept
+        {
+            std::size_t pos = 0;
+            for (std::size_t step = top_; step != 0; step >>= 1)
+            {
+                const std::size_t next = pos + step;
+                if (next < tree_.size() && tree_[next] <= r)
+                {
+                    pos = next;
+                    r -= tree_[next];
+                }
+            }
+            return static_cast<std::uint32_t>(pos);
+        }
+
+    private:
+        std::vector<std::uint64_t> weights_;
+        std::vector<std::uint64_t> tree_; // 1-based Fenwick sums; tree_[0] unused
+        std::size_t top_ = 0;             // highest power of two <= size()
+        std::uint64_t total_ = 0;
+    };
+
+    // ----------------------------
+    // Pity / bad-luck protection: per-attempt odds from a compile-time table
+    // ----------------------------
+    // Per-player state is one small integer: misses since the last hit. The
+    // attempt after m misses hits iff next_u64() < thresholds[m]; attempt
+    // K-1 (after K-1 misses) always hits. Thresholds are 64-bit fixed point
+    // (floor(p * 2^64)), so each chance is rounded down by less than 2^-64.
+    // Every attempt consumes exactly one draw, so the scalar and batch forms
+    // produce the same results from the same engine state.
+    namespace detail
+    {
+        template <std::uint32_t K>
+        using pity_state_t = std::conditional_t<(K <= 0xFFU), std::uint8_t,
+                             std::conditional_t<(K <= 0xFFFFU), std::uint16_t, std::uint32_t>>;
+
+        template <class Derived, std::uint32_t K>
+        struct odds_schedule
+        {
+            static_assert(K >= 1, "odds schedule: K must be >= 1");
+
+            using state_type = pity_state_t<K>;
+
+            // Resolves one attempt from a raw word and updates the miss counter.
+            [[nodiscard]] static constexpr bool step(std::uint64_t x, state_type& misses) noexcept
+            {
+                const bool hit = (static_cast<std::uint32_t>(misses) + 1U >= K) || (x < Derived::thresholds[misses]);
+                misses = hit ? state_type{0} : static_cast<state_type>(misses + 1U);
+                return hit;
+            }
+
+            template <uniform_random_bit_engine Rng>
+            [[nodiscard]] constexpr bool operator()(Rng& rng, state_type& misses) const noexcept
+            {
+                AYEJAY_ODDS_STAT_DRAWS(1);
+                return step(rng.next_u64(), misses);
+            }
+
+            // SoA batch: hits[i] = (*this)(rng, misses[i]) for every player i.
+            template <uniform_random_bit_engine Rng>
+            constexpr void evaluate(Rng& rng, std::span<state_type> misses, std::span<bool> hits) const noexcept
+            {
+                constexpr std::size_t block = 64;
+                std::array<std::uint64_t, block> raw{};
+                for (std::size_t base = 0; base < misses.size(); base += block)
+                {
+                    const std::size_t n = (misses.size() - base < block) ? (misses.size() - base) : block;
+                    const std::span<std::uint64_t> words(raw.data(), n);
+                    if constexpr (requires { rng.fill(words); })
+                        rng.fill(words);
+                    else
+                        for (std::uint64_t& w : words) w = rng.next_u64();
+                    AYEJAY_ODDS_STAT_DRAWS(n);
+
+                    for (std::size_t i = 0; i < n; ++i)
+                        hits[base + i] = step(raw[i], misses[base + i]);
+                }
+            }
+
+            // Hit chance of the attempt after `misses` misses (for display / tooling).
+            [[nodiscard]] static constexpr double chance(std::uint32_t misses) noexcept
+            {
+                if (misses + 1U >= K) return 1.0;
+                return static_cast<double>(Derived::thresholds[misses]) * 0x1.0p-64;
+            }
+        };
+    } // namespace detail
+
+    // Flat 1/N per attempt, guaranteed on attempt K ("hard pity").
+    template <std::uint32_t N, std::uint32_t K>
+    struct pity_odds final : detail::odds_schedule<pity_odds<N, K>, K>
+    {
+        static_assert(N >= 2, "pity_odds<N, K>: N must be >= 2");
+
+        static constexpr std::array<std::uint64_t, K> thresholds = []
+        {
+            std::array<std::uint64_t, K> t{};
+            for (std::uint64_t& v : t) v = detail::recip_lead(N);
+            return t;
+        }();
+    };
+
+    // 1/N per attempt until `Start` misses, then the chance rises by an equal
+    // step per miss so that attempt K (after K-1 misses) is certain
+    // ("soft pity"). Start = 0 ramps from the first miss.
+    template <std::uint32_t N, std::uint32_t K, std::uint32_t Start = 0>
+    struct ramping_odds final : detail::odds_schedule<ramping_odds<N, K, Start>, K>
+    {
+        static_assert(N >= 2, "ramping_odds<N, K, Start>: N must be >= 2");
+        static_assert(K == 1 || Start < K - 1, "ramping_odds<N, K, Start>: Start must be < K - 1");
+
+        static constexpr std::array<std::uint64_t, K> thresholds = []
+        {
+            std::array<std::uint64_t, K> t{};
+            const std::uint64_t base = detail::recip_lead(N);
+            const std::uint64_t span = std::uint64_t{0} - base; // 2^64 - base
+            const std::uint64_t steps = (K > Start + 1) ? (K - 1 - Start) : 1;
+            for (std::uint32_t m = 0; m < K; ++m)
+            {
+                if (m <= Start)
+                {
+                    t[m] = base;
+                    continue;
+                }
+                // base + floor(j * span / steps) without 128-bit arithmetic (j, steps < 2^32).
+                const std::uint64_t j = m - Start;
+                const std::uint64_t ramp = j * (span / steps) + (j * (span % steps)) / steps;
+                t[m] = (j >= steps) ? std::numeric_limits<std::uint64_t>::max() : base + ramp;
+            }
+            return t;
+        }();
+    };
+
+    // ----------------------------
+    // Parallel Monte Carlo with a thread-count independent result
+    // ----------------------------
+    // Trials are cut into fixed-size chunks; chunk c always runs on jump
+    // stream c of xoshiro256ss(seed), whichever worker picks it up. Workers
+    // claim chunks from an atomic counter, and the per-chunk integer counts
+    // are summed, so the total is bit-identical for any thread count.
+    struct monte_carlo_options final
+    {
+        std::size_t threads = 0;                // 0: std::thread::hardware_concurrency()
+        std::uint64_t chunk_trials = 1ULL << 22; // part of the result's identity, like seed
+    };
+
+    namespace detail
+    {
+        using monte_carlo_chunk = std::uint64_t (*)(void* kernel, xoshiro256ss& rng, std::uint64_t trials) noexcept;
+
+        // Stream layout, chunk claiming and the std::jthread pool
+        // (src/monte_carlo.cpp); `chunk` runs one chunk of `kernel`.
+        [[nodiscard]] std::uint64_t monte_carlo_run(std::uint64_t trials, std::uint64_t seed, monte_carlo_options opts,
+                                                    monte_carlo_chunk chunk, void* kernel);
+    } // namespace detail
+
+    // kernel(xoshiro256ss& rng, std::uint64_t trials) -> std::uint64_t, called
+    // once per chunk. It runs on worker threads and must not throw.
+    template <class Kernel>
+    [[nodiscard]] std::uint64_t monte_carlo(std::uint64_t trials, std::uint64_t seed, Kernel kernel,
+                                            monte_carlo_options opts = {})
+    {
+        return detail::monte_carlo_run(trials, seed, opts,
+            [](void* k, xoshiro256ss& rng, std::uint64_t n) noexcept
+            {
+                return static_cast<std::uint64_t>((*static_cast<Kernel*>(k))(rng, n));
+            },
+            &kernel);
+    }
+
+    // Hits among `trials` independent 1/N trials, 64 per bit-sliced mask.
+    template <unsigned_int UInt = std::uint32_t>
+    [[nodiscard]] std::uint64_t monte_carlo_one_in(std::uint64_t trials, std::uint64_t seed, UInt bound,
+                                                   monte_carlo_options opts = {})
+    {
+        return monte_carlo(trials, seed,
+            [bound](xoshiro256ss& rng, std::uint64_t n) noexcept
+            {
+                std::array<std::uint64_t, 64> masks;
+                std::uint64_t hits = 0;
+                while (n >= 64)
+                {
+                    const std::uint64_t words = n / 64 < masks.size() ? n / 64 : masks.size();
+                    const std::span<std::uint64_t> out(masks.data(), static_cast<std::size_t>(words));
+                    one_in_bits(rng, bound, out);
+                    for (const std::uint64_t m : out)
+                        hits += static_cast<std::uint64_t>(std::popcount(m));
+                    n -= words * 64;
+                }
+                if (n != 0)
+                {
+                    const std::uint64_t keep = (std::uint64_t{1} << n) - 1;
+                    hits += static_cast<std::uint64_t>(std::popcount(one_in_mask(rng, bound) & keep));
+                }
+                return hits;
+            },
+            opts);
+    }
+
+} // namespace ayejay::odds
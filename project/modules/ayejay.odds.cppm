@@ -1,3 +1,12 @@
+// ayejay.odds - named module over odds.hpp
+//
+// `import ayejay.odds;` exports every public name of the header. Out-of-line
+// pieces (SIMD kernels, table builds, stats registry, monte_carlo pool) are
+// in the ayejay_odds library, so link it either way. Toolchains without named
+// module support can `import <ayejay/odds.hpp>;` as a header unit, or include
+// it; the entities are the same in all three forms. Configuration macros
+// (AYEJAY_ODDS_STATS, AYEJAY_ODDS_CACHE_LINE, ...) must match the library
+// build, so set them on the target rather than per importer.
 module;
 
 #include "ayejay/odds.hpp"
@@ -6,14 +15,77 @@ export module ayejay.odds;
 
 export namespace ayejay::odds
 {
+    using ::ayejay::odds::unsigned_int;
+    using ::ayejay::odds::rotl64;
     using ::ayejay::odds::splitmix64;
     using ::ayejay::odds::xoshiro256ss;
+    using ::ayejay::odds::simd_level;
+    using ::ayejay::odds::detected_simd_level;
+    using ::ayejay::odds::simd_level_supported;
+    using ::ayejay::odds::xoshiro256ss_lanes;
+    using ::ayejay::odds::xoshiro256ss_x4;
+    using ::ayejay::odds::xoshiro256ss_x8;
+    using ::ayejay::odds::philox4x32;
+    using ::ayejay::odds::uniform_random_bit_engine;
+    using ::ayejay::odds::wyrand;
+    using ::ayejay::odds::romu_duo_jr;
+    using ::ayejay::odds::xoroshiro128p;
+    using ::ayejay::odds::pcg64_dxsm;
+    using ::ayejay::odds::default_engine;
     using ::ayejay::odds::thread_rng;
     using ::ayejay::odds::seed_thread;
+    using ::ayejay::odds::seed_strategy;
+    using ::ayejay::odds::set_seed_strategy;
+    using ::ayejay::odds::get_seed_strategy;
+    using ::ayejay::odds::set_process_seed;
+    using ::ayejay::odds::warm_seed_pool;
+    using ::ayejay::odds::stats_enabled;
+    using ::ayejay::odds::bound_calls;
+    using ::ayejay::odds::odds_stats;
+    using ::ayejay::odds::stats_snapshot;
+    using ::ayejay::odds::thread_stats_snapshot;
+    using ::ayejay::odds::reset_stats;
+    using ::ayejay::odds::cache_line_size;
+    using ::ayejay::odds::state_format_version;
+    using ::ayejay::odds::xoshiro256ss_state_size;
+    using ::ayejay::odds::checkpoint_state_size;
+    using ::ayejay::odds::save;
+    using ::ayejay::odds::restore;
+    using ::ayejay::odds::xoshiro256ss_checkpoint;
+    using ::ayejay::odds::counting_xoshiro256ss;
+    using ::ayejay::odds::cache_padded;
+    using ::ayejay::odds::padded_xoshiro256ss;
+    using ::ayejay::odds::rng_bank;
+    using ::ayejay::odds::rng_pool;
     using ::ayejay::odds::uniform_bounded;
+    using ::ayejay::odds::uniform_bounded_fill;
+    using ::ayejay::odds::bounded_sampler;
+    using ::ayejay::odds::uniform_double;
+    using ::ayejay::odds::uniform_float;
+    using ::ayejay::odds::uniform_double_fill;
+    using ::ayejay::odds::uniform_float_fill;
+    using ::ayejay::odds::uniform_int;
+    using ::ayejay::odds::shuffle;
+    using ::ayejay::odds::sample_k;
     using ::ayejay::odds::one_in;
+    using ::ayejay::odds::one_in_fill;
+    using ::ayejay::odds::one_in_fast;
+    using ::ayejay::odds::bernoulli;
+    using ::ayejay::odds::probability;
+    using ::ayejay::odds::m_in_n;
+    using ::ayejay::odds::one_in_mask;
+    using ::ayejay::odds::one_in_bits;
+    using ::ayejay::odds::geometric_skip;
+    using ::ayejay::odds::next_hit;
+    using ::ayejay::odds::for_each_hit;
+    using ::ayejay::odds::binomial;
+    using ::ayejay::odds::binomial_count;
     using ::ayejay::odds::one_in_t;
     using ::ayejay::odds::one_in_v;
+    using ::ayejay::odds::m_in_n_t;
+    using ::ayejay::odds::m_in_n_v;
+    using ::ayejay::odds::chance_t;
+    using ::ayejay::odds::chance_v;
 
     using ::ayejay::odds::p2;
     using ::ayejay::odds::p3;
@@ -39,4 +111,16 @@ export namespace ayejay::odds
     using ::ayejay::odds::one_in_25;
     using ::ayejay::odds::one_in_50;
     using ::ayejay::odds::one_in_100;
+
+    using ::ayejay::odds::normal;
+    using ::ayejay::odds::normal_fill;
+    using ::ayejay::odds::exponential;
+    using ::ayejay::odds::exponential_fill;
+    using ::ayejay::odds::weighted_table;
+    using ::ayejay::odds::dynamic_weighted_table;
+    using ::ayejay::odds::pity_odds;
+    using ::ayejay::odds::ramping_odds;
+    using ::ayejay::odds::monte_carlo_options;
+    using ::ayejay::odds::monte_carlo;
+    using ::ayejay::odds::monte_carlo_one_in;
 }
@@ -0,0 +1,61 @@
+// monte_carlo.cpp - worker pool behind monte_carlo()
+//
+// The kernel arrives type-erased (one indirect call per chunk of millions of
+// trials), so <thread> and the pool code are compiled once.
+
+#include <ayejay/odds.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace ayejay::odds::detail
+{
+    std::uint64_t monte_carlo_run(std::uint64_t trials, std::uint64_t seed, monte_carlo_options opts,
+                                  monte_carlo_chunk chunk_fn, void* kernel)
+    {
+        if (trials == 0) return 0;
+
+        const std::uint64_t chunk = opts.chunk_trials == 0 ? 1 : opts.chunk_trials;
+        const std::uint64_t chunks = (trials - 1) / chunk + 1;
+
+        // Chunk c runs on base.stream(c), derived when a worker claims it. A
+        // worker's claims are roughly `threads` apart, so stepping from its
+        // previous stream costs O(log threads) polynomial multiplications and
+        // nothing is laid out (or jumped serially) before the workers start.
+        const xoshiro256ss base(seed);
+
+        std::atomic<std::uint64_t> next{ 0 };
+        std::atomic<std::uint64_t> total{ 0 };
+        const auto work = [&]
+        {
+            std::uint64_t sum = 0;
+            xoshiro256ss stream = base;
+            std::uint64_t at = 0;
+            for (std::uint64_t c = next.fetch_add(1, std::memory_order_relaxed); c < chunks;
+                 c = next.fetch_add(1, std::memory_order_relaxed))
+            {
+                stream = stream.stream(c - at);
+                at = c;
+
+                xoshiro256ss rng = stream;
+                const std::uint64_t n = (c + 1 == chunks) ? trials - c * chunk : chunk;
+                sum += chunk_fn(kernel, rng, n);
+            }
+            total.fetch_add(sum, std::memory_order_relaxed);
+        };
+
+        std::size_t threads = opts.threads != 0 ? opts.threads : std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+        if (threads > chunks) threads = static_cast<std::size_t>(chunks);
+
+        {
+            std::vector<std::jthread> pool;
+            pool.reserve(threads - 1);
+            for (std::size_t t = 1; t < threads; ++t)
+                pool.emplace_back(work);
+            work();
+        }
+        return total.load(std::memory_order_relaxed);
+    }
+} // namespace ayejay::odds::detail
@@ -0,0 +1,48 @@
+// platform.cpp - OS-facing helpers: entropy and the current CPU index
+//
+// Keeps <random> and the OS headers out of odds.hpp.
+
+#include <ayejay/odds.hpp>
+
+#include <random>
+
+#if defined(__linux__)
+  #include <sched.h>
+#elif defined(_WIN32)
+  #if !defined(WIN32_LEAN_AND_MEAN)
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #if !defined(NOMINMAX)
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#endif
+
+namespace ayejay::odds::detail
+{
+    std::uint64_t entropy_seed() noexcept
+    {
+        // random_device quality varies by platform; we mix multiple pulls.
+        std::random_device rd;
+        std::uint64_t a = (static_cast<std::uint64_t>(rd()) << 32) ^ static_cast<std::uint64_t>(rd());
+        std::uint64_t b = (static_cast<std::uint64_t>(rd()) << 32) ^ static_cast<std::uint64_t>(rd());
+        std::uint64_t c = (static_cast<std::uint64_t>(rd()) << 32) ^ static_cast<std::uint64_t>(rd());
+        return a ^ rotl64(b, 21) ^ rotl64(c, 43) ^ 0xD6E8FEB86659FD93ULL;
+    }
+
+#if defined(AYEJAY_ODDS_HAS_CURRENT_CPU)
+    std::size_t current_cpu() noexcept
+    {
+#if defined(__linux__)
+        // Fails only on kernels without getcpu (before 2.6.19).
+        const int cpu = sched_getcpu();
+        return cpu >= 0 ? static_cast<std::size_t>(cpu) : 0;
+#else
+        // Processor groups hold up to 64 logical processors each.
+        PROCESSOR_NUMBER pn{};
+        GetCurrentProcessorNumberEx(&pn);
+        return static_cast<std::size_t>(pn.Group) * 64 + pn.Number;
+#endif
+    }
+#endif
+} // namespace ayejay::odds::detail
@@ -0,0 +1,263 @@
+// simd.cpp - CPU feature detection and the multi-lane xoshiro256** kernels
+//
+// Compiled once into ayejay_odds: the kernels are large, need <immintrin.h> /
+// <arm_neon.h>, and are only reached through detail::lanes_generate().
+
+#include <ayejay/odds.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64)
+  #define AYEJAY_ODDS_X86_64 1
+  #include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+  #define AYEJAY_ODDS_NEON 1
+  #include <arm_neon.h>
+#endif
+
+// Per-function ISA enablement for runtime-dispatched kernels. MSVC accepts
+// the intrinsics without it; GCC/Clang (including clang-cl) need the attribute.
+#if defined(__GNUC__) || defined(__clang__)
+  #define AYEJAY_ODDS_TARGET(isa) __attribute__((target(isa)))
+#else
+  #define AYEJAY_ODDS_TARGET(isa)
+#endif
+
+namespace ayejay::odds
+{
+    namespace
+    {
+#if defined(AYEJAY_ODDS_X86_64)
+        // _xgetbv needs the xsave target under clang-cl; the attribute only
+        // exists on x86, so other targets compile the plain definition below.
+        AYEJAY_ODDS_TARGET("xsave")
+#endif
+        [[nodiscard]] simd_level detect_simd_level() noexcept
+        {
+#if defined(AYEJAY_ODDS_X86_64) && defined(_MSC_VER)
+            int r[4]{};
+            __cpuid(r, 0);
+            if (r[0] < 7) return simd_level::scalar;
+
+            __cpuid(r, 1);
+            const bool osxsave = (r[2] & (1 << 27)) != 0;
+            const bool avx = (r[2] & (1 << 28)) != 0;
+            if (!osxsave || !avx) return simd_level::scalar;
+
+            const unsigned long long xcr0 = _xgetbv(0);
+            if ((xcr0 & 0x6) != 0x6) return simd_level::scalar;
+
+            __cpuidex(r, 7, 0);
+            const bool avx2 = (r[1] & (1 << 5)) != 0;
+            const bool avx512f = (r[1] & (1 << 16)) != 0;
+            if (avx512f && (xcr0 & 0xE6) == 0xE6) return simd_level::avx512;
+            return avx2 ? simd_level::avx2 : simd_level::scalar;
+
+#elif defined(AYEJAY_ODDS_X86_64)
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return simd_level::avx512;
+            if (__builtin_cpu_supports("avx2")) return simd_level::avx2;
+            return simd_level::scalar;
+
+#elif defined(AYEJAY_ODDS_NEON)
+            return simd_level::neon;
+
+#else
+            return simd_level::scalar;
+#endif
+        }
+    } // namespace
+
+    simd_level detected_simd_level() noexcept
+    {
+        static const simd_level level = detect_simd_level();
+        return level;
+    }
+
+    bool simd_level_supported(simd_level level) noexcept
+    {
+        switch (level)
+        {
+        case simd_level::scalar:
+            return true;
+#if defined(AYEJAY_ODDS_X86_64)
+        case simd_level::avx2:
+            return detected_simd_level() == simd_level::avx2 || detected_simd_level() == simd_level::avx512;
+        case simd_level::avx512:
+            return detected_simd_level() == simd_level::avx512;
+#elif defined(AYEJAY_ODDS_NEON)
+        case simd_level::neon:
+            return true;
+#endif
+        default:
+            return false;
+        }
+    }
+
+    namespace detail
+    {
+        namespace
+        {
+            // Advance lanes [first, v.lanes) `steps` times, writing
+            // out[step * v.lanes + lane]. Plain loops; vectorizable as written.
+            void lanes_kernel_scalar(const lanes_view& v, std::size_t first,
+                                     std::uint64_t* out, std::size_t steps) noexcept
+            {
+                for (std::size_t k = 0; k < steps; ++k)
+                {
+                    std::uint64_t* row = out + k * v.lanes;
+                    for (std::size_t i = first; i < v.lanes; ++i)
+                    {
+                        row[i] = rotl64(v.s1[i] * 5ULL, 7) * 9ULL;
+                        const std::uint64_t t = v.s1[i] << 17;
+
+                        v.s2[i] ^= v.s0[i];
+                        v.s3[i] ^= v.s1[i];
+                        v.s1[i] ^= v.s2[i];
+                        v.s0[i] ^= v.s3[i];
+
+                        v.s2[i] ^= t;
+                        v.s3[i] = rotl64(v.s3[i], 45);
+                    }
+                }
+            }
+
+#if defined(AYEJAY_ODDS_X86_64)
+            // Returns the first lane not handled (multiple of 4).
+            AYEJAY_ODDS_TARGET("avx2")
+            std::size_t lanes_kernel_avx2(const lanes_view& v, std::size_t first,
+                                          std::uint64_t* out, std::size_t steps) noexcept
+            {
+                std::size_t g = first;
+                for (; g + 4 <= v.lanes; g += 4)
+                {
+                    __m256i s0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v.s0 + g));
+                    __m256i s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v.s1 + g));
+                    __m256i s2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v.s2 + g));
+                    __m256i s3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v.s3 + g));
+
+                    for (std::size_t k = 0; k < steps; ++k)
+                    {
+                        // No 64-bit vector multiply in AVX2: x*5 and x*9 as shift+add.
+                        const __m256i m5 = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);
+                        const __m256i r7 = _mm256_or_si256(_mm256_slli_epi64(m5, 7), _mm256_srli_epi64(m5, 57));
+                        const __m256i res = _mm256_add_epi64(_mm256_slli_epi64(r7, 3), r7);
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k * v.lanes + g), res);
+
+                        const __m256i t = _mm256_slli_epi64(s1, 17);
+                        s2 = _mm256_xor_si256(s2, s0);
+                        s3 = _mm256_xor_si256(s3, s1);
+                        s1 = _mm256_xor_si256(s1, s2);
+                        s0 = _mm256_xor_si256(s0, s3);
+                        s2 = _mm256_xor_si256(s2, t);
+                        s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+                    }
+
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(v.s0 + g), s0);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(v.s1 + g), s1);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(v.s2 + g), s2);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(v.s3 + g), s3);
+                }
+                return g;
+            }
+
+#if defined(__GNUC__) && !defined(__clang__)
+  #pragma GCC diagnostic push
+  // GCC 12 flags _mm512_undefined_epi32() inside its own intrinsic headers.
+  #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+            AYEJAY_ODDS_TARGET("avx512f")
+            std::size_t lanes_kernel_avx512(const lanes_view& v, std::size_t first,
+                                            std::uint64_t* out, std::size_t steps) noexcept
+            {
+                std::size_t g = first;
+                for (; g + 8 <= v.lanes; g += 8)
+                {
+                    __m512i s0 = _mm512_loadu_si512(v.s0 + g);
+                    __m512i s1 = _mm512_loadu_si512(v.s1 + g);
+                    __m512i s2 = _mm512_loadu_si512(v.s2 + g);
+                    __m512i s3 = _mm512_loadu_si512(v.s3 + g);
+
+                    for (std::size_t k = 0; k < steps; ++k)
+                    {
+                        const __m512i m5 = _mm512_add_epi64(_mm512_slli_epi64(s1, 2), s1);
+                        const __m512i r7 = _mm512_rol_epi64(m5, 7);
+                        const __m512i res = _mm512_add_epi64(_mm512_slli_epi64(r7, 3), r7);
+                        _mm512_storeu_si512(out + k * v.lanes + g, res);
+
+                        const __m512i t = _mm512_slli_epi64(s1, 17);
+                        s2 = _mm512_xor_si512(s2, s0);
+                        s3 = _mm512_xor_si512(s3, s1);
+                        s1 = _mm512_xor_si512(s1, s2);
+                        s0 = _mm512_xor_si512(s0, s3);
+                        s2 = _mm512_xor_si512(s2, t);
+                        s3 = _mm512_rol_epi64(s3, 45);
+                    }
+
+                    _mm512_storeu_si512(v.s0 + g, s0);
+                    _mm512_storeu_si512(v.s1 + g, s1);
+                    _mm512_storeu_si512(v.s2 + g, s2);
+                    _mm512_storeu_si512(v.s3 + g, s3);
+                }
+                return g;
+            }
+#if defined(__GNUC__) && !defined(__clang__)
+  #pragma GCC diagnostic pop
+#endif
+#endif
+
+#if defined(AYEJAY_ODDS_NEON)
+            std::size_t lanes_kernel_neon(const lanes_view& v, std::size_t first,
+                                          std::uint64_t* out, std::size_t steps) noexcept
+            {
+                std::size_t g = first;
+                for (; g + 2 <= v.lanes; g += 2)
+                {
+                    uint64x2_t s0 = vld1q_u64(v.s0 + g);
+                    uint64x2_t s1 = vld1q_u64(v.s1 + g);
+                    uint64x2_t s2 = vld1q_u64(v.s2 + g);
+                    uint64x2_t s3 = vld1q_u64(v.s3 + g);
+
+                    for (std::size_t k = 0; k < steps; ++k)
+                    {
+                        const uint64x2_t m5 = vaddq_u64(vshlq_n_u64(s1, 2), s1);
+                        const uint64x2_t r7 = vorrq_u64(vshlq_n_u64(m5, 7), vshrq_n_u64(m5, 57));
+                        const uint64x2_t res = vaddq_u64(vshlq_n_u64(r7, 3), r7);
+                        vst1q_u64(out + k * v.lanes + g, res);
+
+                        const uint64x2_t t = vshlq_n_u64(s1, 17);
+                        s2 = veorq_u64(s2, s0);
+                        s3 = veorq_u64(s3, s1);
+                        s1 = veorq_u64(s1, s2);
+                        s0 = veorq_u64(s0, s3);
+                        s2 = veorq_u64(s2, t);
+                        s3 = vorrq_u64(vshlq_n_u64(s3, 45), vshrq_n_u64(s3, 19));
+                    }
+
+                    vst1q_u64(v.s0 + g, s0);
+                    vst1q_u64(v.s1 + g, s1);
+                    vst1q_u64(v.s2 + g, s2);
+                    vst1q_u64(v.s3 + g, s3);
+                }
+                return g;
+            }
+#endif
+        } // namespace
+
+        void lanes_generate(const lanes_view& v, std::uint64_t* out, std::size_t steps,
+                            simd_level level) noexcept
+        {
+            std::size_t done = 0;
+#if defined(AYEJAY_ODDS_X86_64)
+            if (level == simd_level::avx512)
+                done = lanes_kernel_avx512(v, done, out, steps);
+            if (level == simd_level::avx512 || level == simd_level::avx2)
+                done = lanes_kernel_avx2(v, done, out, steps);
+#elif defined(AYEJAY_ODDS_NEON)
+            if (level == simd_level::neon)
+                done = lanes_kernel_neon(v, done, out, steps);
+#endif
+            (void)level;
+            if (done < v.lanes)
+                lanes_kernel_scalar(v, done, out, steps);
+        }
+    } // namespace detail
+} // namespace ayejay::odds
@@ -0,0 +1,165 @@
+// stats.cpp - process-wide registry behind the AYEJAY_ODDS_STATS counters
+//
+// The per-call hooks stay inline in odds.hpp; only thread registration and
+// snapshots live here, so they are compiled once.
+
+#include <ayejay/odds.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace ayejay::odds
+{
+#if defined(AYEJAY_ODDS_STATS)
+    namespace detail
+    {
+        namespace
+        {
+            void stats_add_bound(odds_stats& out, std::uint64_t bound, bool compile_time, std::uint64_t calls)
+            {
+                for (bound_calls& b : out.bounds)
+                {
+                    if (b.bound == bound && b.compile_time == compile_time)
+                    {
+                        b.calls += calls;
+                        return;
+                    }
+                }
+                out.bounds.push_back({ bound, calls, compile_time });
+            }
+
+            void stats_add(odds_stats& out, const odds_stats& in)
+            {
+                out.draws += in.draws;
+                out.rejections += in.rejections;
+                out.calls += in.calls;
+                out.other_draws += in.other_draws;
+                out.other_calls += in.other_calls;
+                for (const bound_calls& b : in.bounds)
+                    stats_add_bound(out, b.bound, b.compile_time, b.calls);
+            }
+
+            void stats_add(odds_stats& out, const stats_slot& slot)
+            {
+                const std::uint64_t rejections = slot.rejections.load(std::memory_order_relaxed);
+                const std::uint64_t calls = slot.calls.load(std::memory_order_relaxed);
+                const std::uint64_t other_draws = slot.other_draws.load(std::memory_order_relaxed);
+                out.draws += calls + rejections + other_draws;
+                out.rejections += rejections;
+                out.calls += calls;
+                out.other_draws += other_draws;
+                out.other_calls += slot.other_calls.load(std::memory_order_relaxed);
+                for (std::size_t i = 0; i < stats_bound_slots; ++i)
+                {
+                    const std::uint64_t bound = slot.bounds[i].load(std::memory_order_acquire);
+                    if (bound != 0)
+                        stats_add_bound(out, bound, slot.compile_time[i].load(std::memory_order_relaxed),
+                                        slot.counts[i].load(std::memory_order_relaxed));
+                }
+            }
+
+            // out -= base. Counters only grow, so every base entry is covered.
+            void stats_subtract(odds_stats& out, const odds_stats& base) noexcept
+            {
+                out.draws -= base.draws;
+                out.rejections -= base.rejections;
+                out.calls -= base.calls;
+                out.other_draws -= base.other_draws;
+                out.other_calls -= base.other_calls;
+                for (const bound_calls& b : base.bounds)
+                    for (bound_calls& o : out.bounds)
+                        if (o.bound == b.bound && o.compile_time == b.compile_time) o.calls -= b.calls;
+            }
+
+            void stats_finish(odds_stats& s)
+            {
+                std::erase_if(s.bounds, [](const bound_calls& b) { return b.calls == 0; });
+                std::sort(s.bounds.begin(), s.bounds.end(), [](const bound_calls& a, const bound_calls& b) {
+                    if (a.calls != b.calls) return a.calls > b.calls;
+                    return a.bound != b.bound ? a.bound < b.bound : a.compile_time < b.compile_time;
+                });
+            }
+
+            // Live slots, totals of threads that have exited, and the totals at
+            // the last reset_stats() (slots are never written by other threads,
+            // so a reset records a baseline instead of zeroing).
+            struct stats_registry final
+            {
+                std::mutex mutex;
+                std::vector<stats_slot*> live;
+                odds_stats retired;
+                odds_stats baseline;
+            };
+
+            // Never destroyed: threads may still exit after static destruction.
+            [[nodiscard]] stats_registry& stats_reg() noexcept
+            {
+                static stats_registry* const reg = new stats_registry;
+                return *reg;
+            }
+
+            // Caller holds reg.mutex.
+            [[nodiscard]] odds_stats stats_totals(const stats_registry& reg)
+            {
+                odds_stats s;
+                stats_add(s, reg.retired);
+                for (const stats_slot* slot : reg.live)
+                    stats_add(s, *slot);
+                s.threads = reg.live.size();
+                return s;
+            }
+        } // namespace
+
+        stats_thread::stats_thread()
+        {
+            stats_registry& reg = stats_reg();
+            const std::lock_guard lock(reg.mutex);
+            reg.live.push_back(&slot);
+        }
+
+        stats_thread::~stats_thread()
+        {
+            stats_registry& reg = stats_reg();
+            const std::lock_guard lock(reg.mutex);
+            stats_add(reg.retired, slot);
+            std::erase(reg.live, &slot);
+        }
+    } // namespace detail
+#endif
+
+    odds_stats stats_snapshot()
+    {
+        odds_stats s;
+#if defined(AYEJAY_ODDS_STATS)
+        detail::stats_registry& reg = detail::stats_reg();
+        {
+            const std::lock_guard lock(reg.mutex);
+            s = detail::stats_totals(reg);
+            detail::stats_subtract(s, reg.baseline);
+        }
+        detail::stats_finish(s);
+#endif
+        return s;
+    }
+
+    odds_stats thread_stats_snapshot()
+    {
+        odds_stats s;
+#if defined(AYEJAY_ODDS_STATS)
+        detail::stats_add(s, detail::thread_stats_slot());
+        s.threads = 1;
+        detail::stats_finish(s);
+#endif
+        return s;
+    }
+
+    void reset_stats()
+    {
+#if defined(AYEJAY_ODDS_STATS)
+        detail::stats_registry& reg = detail::stats_reg();
+        const std::lock_guard lock(reg.mutex);
+        reg.baseline = detail::stats_totals(reg);
+#endif
+    }
+} // namespace ayejay::odds
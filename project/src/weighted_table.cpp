@@ -0,0 +1,83 @@
+// weighted_table.cpp - table builds for weighted_table / dynamic_weighted_table
+//
+// Builds are O(n) and run at load time; draws stay inline in odds.hpp.
+
+#include <ayejay/odds.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace ayejay::odds
+{
+    namespace
+    {
+        [[nodiscard]] std::uint64_t to_threshold(double p) noexcept
+        {
+            if (!(p > 0.0)) return 0;
+            if (p >= 1.0) return std::numeric_limits<std::uint64_t>::max();
+            return static_cast<std::uint64_t>(p * 0x1.0p64);
+        }
+    } // namespace
+
+    void weighted_table::build(std::span<const double> weights)
+    {
+        const std::size_t n = weights.size();
+        keep_.assign(n, std::numeric_limits<std::uint64_t>::max());
+        alias_.resize(n);
+        index_ = bounded_sampler<std::uint32_t>(static_cast<std::uint32_t>(n));
+        if (n == 0) return;
+
+        double total = 0.0;
+        for (const double w : weights)
+            if (w > 0.0) total += w;
+
+        // Scaled so the average column is exactly 1.
+        std::vector<double> scaled(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            scaled[i] = (total > 0.0) ? ((weights[i] > 0.0 ? weights[i] : 0.0) * static_cast<double>(n) / total) : 1.0;
+            alias_[i] = static_cast<std::uint32_t>(i);
+        }
+
+        std::vector<std::uint32_t> small;
+        std::vector<std::uint32_t> large;
+        small.reserve(n);
+        large.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+            (scaled[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+
+        while (!small.empty() && !large.empty())
+        {
+            const std::uint32_t s = small.back();
+            small.pop_back();
+            const std::uint32_t l = large.back();
+
+            keep_[s] = to_threshold(scaled[s]);
+            alias_[s] = l;
+
+            scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+            if (scaled[l] < 1.0)
+            {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+        // Leftovers are full columns (up to rounding) and keep their defaults.
+    }
+
+    dynamic_weighted_table::dynamic_weighted_table(std::span<const std::uint64_t> weights)
+        : dynamic_weighted_table(weights.size())
+    {
+        const std::size_t n = weights.size();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            weights_[i] = weights[i];
+            tree_[i + 1] += weights[i];
+            total_ += weights[i];
+
+            const std::size_t parent = (i + 1) + ((i + 1) & (~(i + 1) + 1));
+            if (parent <= n)
+                tree_[parent] += tree_[i + 1];
+        }
+    }
+} // namespace ayejay::odds
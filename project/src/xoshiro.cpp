@@ -0,0 +1,13 @@
+// xoshiro.cpp - one-time checks of the xoshiro256** jump polynomials
+//
+// 192 constexpr GF(2) squarings are too slow to repeat in every translation
+// unit that includes odds.hpp, so they are evaluated once here.
+
+#include <ayejay/odds.hpp>
+
+namespace ayejay::odds
+{
+    // jump_poly == x^(2^128), long_jump_poly == jump_poly^(2^64) == x^(2^192).
+    static_assert(xoshiro256ss::jump_poly == detail::gf2_square_n({ { 2, 0, 0, 0 } }, 128, xoshiro256ss::char_poly));
+    static_assert(xoshiro256ss::long_jump_poly == detail::gf2_square_n(xoshiro256ss::jump_poly, 64, xoshiro256ss::char_poly));
+} // namespace ayejay::odds
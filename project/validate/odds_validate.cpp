@@ -0,0 +1,867 @@
+// odds_validate.cpp - statistical checks and raw streams for ayejay::odds
+//
+// Build with -DEPOCH_BUILD_VALIDATE=ON.
+//
+//   ayejay_odds_validate [tests] [--seed S] [--scale K]
+//       Chi-square / Kolmogorov-Smirnov tests of every sampling path against
+//       its exact distribution, with the throughput of each path. Exits 1 if
+//       any test fails (p < 1e-6).
+//   ayejay_odds_validate stream [engine] [--seed S] [--bytes N]
+//       Raw next_u64() output (little-endian words) on stdout, e.g.
+//         ayejay_odds_validate stream xoshiro256ss | RNG_test stdin64
+//       Endless unless --bytes is given.
+//   ayejay_odds_validate throughput
+//       Raw fill() throughput of every engine in GB/s.
+//
+// Tests are seeded and deterministic, so a failure reproduces exactly. A
+// "weak" result (p < 1e-3) is expected about once per thousand tests; rerun
+// with another --seed before treating it as a defect.
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numbers>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#if defined(_WIN32)
+  #include <fcntl.h>
+  #include <io.h>
+#endif
+
+#include <ayejay/odds.hpp>
+
+namespace
+{
+    using namespace ayejay::odds;
+
+    // ----------------------------
+    // Distribution functions
+    // ----------------------------
+
+    // Regularized upper incomplete gamma Q(a, x): series for x < a + 1,
+    // Lentz continued fraction otherwise.
+    double gamma_q(double a, double x)
+    {
+        if (x <= 0.0) return 1.0;
+
+        const double log_prefix = -x + a * std::log(x) - std::lgamma(a);
+        if (x < a + 1.0)
+        {
+            double term = 1.0 / a;
+            double sum = term;
+            for (int n = 1; n < 100000; ++n)
+            {
+                term *= x / (a + n);
+                sum += term;
+                if (std::fabs(term) < std::fabs(sum) * 1e-16) break;
+            }
+            return std::max(0.0, 1.0 - sum * std::exp(log_prefix));
+        }
+
+        constexpr double tiny = 1e-300;
+        double b = x + 1.0 - a;
+        double c = 1.0 / tiny;
+        double d = 1.0 / b;
+        double h = d;
+        for (int i = 1; i < 100000; ++i)
+        {
+            const double an = -i * (i - a);
+            b += 2.0;
+            d = an * d + b;
+            if (std::fabs(d) < tiny) d = tiny;
+            c = b + an / c;
+            if (std::fabs(c) < tiny) c = tiny;
+            d = 1.0 / d;
+            const double delta = d * c;
+            h *= delta;
+            if (std::fabs(delta - 1.0) < 1e-16) break;
+        }
+        return std::exp(log_prefix) * h;
+    }
+
+    double chi_square_p(double stat, double df)
+    {
+        return gamma_q(df / 2.0, stat / 2.0);
+    }
+
+    // P(K > lambda) for the Kolmogorov distribution; the two series converge
+    // quickly on either side of 1.18.
+    double kolmogorov_q(double lambda)
+    {
+        if (lambda <= 0.0) return 1.0;
+
+        if (lambda < 1.18)
+        {
+            const double pi2 = std::numbers::pi * std::numbers::pi;
+            double cdf = 0.0;
+            for (int k = 1; k <= 20; ++k)
+            {
+                const double m = 2.0 * k - 1.0;
+                cdf += std::exp(-m * m * pi2 / (8.0 * lambda * lambda));
+            }
+            cdf *= std::sqrt(2.0 * std::numbers::pi) / lambda;
+            return std::clamp(1.0 - cdf, 0.0, 1.0);
+        }
+
+        double q = 0.0;
+        for (int k = 1; k <= 100; ++k)
+        {
+            const double term = std::exp(-2.0 * k * k * lambda * lambda);
+            q += (k % 2 == 1) ? term : -term;
+            if (term < 1e-18) break;
+        }
+        return std::clamp(2.0 * q, 0.0, 1.0);
+    }
+
+    double normal_cdf(double x)
+    {
+        return 0.5 * std::erfc(-x / std::numbers::sqrt2);
+    }
+
+    double exponential_cdf(double x)
+    {
+        return x <= 0.0 ? 0.0 : -std::expm1(-x);
+    }
+
+    double uniform_cdf(double x)
+    {
+        return std::clamp(x, 0.0, 1.0);
+    }
+
+    double binomial_pmf(std::uint64_t n, double p, std::uint64_t k)
+    {
+        const double nd = static_cast<double>(n);
+        const double kd = static_cast<double>(k);
+        const double log_c = std::lgamma(nd + 1.0) - std::lgamma(kd + 1.0) - std::lgamma(nd - kd + 1.0);
+        return std::exp(log_c + kd * std::log(p) + (nd - kd) * std::log1p(-p));
+    }
+
+    // ----------------------------
+    // Test statistics
+    // ----------------------------
+    struct test_result
+    {
+        double stat = 0.0;
+        double df = 0.0; // 0 for KS
+        double p = 1.0;
+    };
+
+    // Pearson chi-square of observed counts against expected probabilities.
+    // Adjacent cells are pooled until each expects at least 5 hits (tails
+    // of binomial / geometric / normal pmfs). Cells with probability 0 must
+    // stay empty; any hit there fails the test outright.
+    test_result chi_square(std::span<const std::uint64_t> observed, std::span<const double> prob, std::uint64_t n)
+    {
+        double stat = 0.0;
+        std::size_t cells = 0;
+        double pooled_e = 0.0;
+        double pooled_o = 0.0;
+        double last_e = 0.0;
+        double last_o = 0.0;
+        const double total = static_cast<double>(n);
+
+        for (std::size_t i = 0; i < observed.size(); ++i)
+        {
+            if (prob[i] == 0.0)
+            {
+                if (observed[i] != 0) return { std::numeric_limits<double>::infinity(), 0.0, 0.0 };
+                continue;
+            }
+
+            pooled_e += prob[i] * total;
+            pooled_o += static_cast<double>(observed[i]);
+            if (pooled_e >= 5.0)
+            {
+                const double d = pooled_o - pooled_e;
+                stat += d * d / pooled_e;
+                ++cells;
+                last_e = pooled_e;
+                last_o = pooled_o;
+                pooled_e = 0.0;
+                pooled_o = 0.0;
+            }
+        }
+        if (pooled_e > 0.0 && cells != 0)
+        {
+            // Fold the short tail into the last full cell.
+            const double d_old = last_o - last_e;
+            const double d_new = last_o + pooled_o - (last_e + pooled_e);
+            stat += d_new * d_new / (last_e + pooled_e) - d_old * d_old / last_e;
+        }
+
+        const double df = cells > 1 ? static_cast<double>(cells - 1) : 1.0;
+        return { stat, df, chi_square_p(stat, df) };
+    }
+
+    test_result chi_square_uniform(std::span<const std::uint64_t> observed, std::uint64_t n)
+    {
+        const std::vector<double> prob(observed.size(), 1.0 / static_cast<double>(observed.size()));
+        return chi_square(observed, prob, n);
+    }
+
+    // One-sample KS against a continuous CDF; sorts the sample.
+    template <class Cdf>
+    test_result kolmogorov_smirnov(std::vector<double>& x, Cdf cdf)
+    {
+        std::sort(x.begin(), x.end());
+        const double n = static_cast<double>(x.size());
+        double d = 0.0;
+        for (std::size_t i = 0; i < x.size(); ++i)
+        {
+            const double f = cdf(x[i]);
+            d = std::max(d, std::max(f - static_cast<double>(i) / n, static_cast<double>(i + 1) / n - f));
+        }
+        const double sn = std::sqrt(n);
+        return { d, 0.0, kolmogorov_q((sn + 0.12 + 0.11 / sn) * d) };
+    }
+
+    // ----------------------------
+    // Reporting
+    // ----------------------------
+    constexpr double fail_p = 1e-6;
+    constexpr double weak_p = 1e-3;
+
+    struct report
+    {
+        int tests = 0;
+        int weak = 0;
+        int failed = 0;
+
+        void header() const
+        {
+            std::printf("%-44s %12s %12s %6s %10s %6s %10s\n", "test", "n", "stat", "df", "p", "", "M/s");
+        }
+
+        // items / seconds is the sampling throughput only (analysis excluded).
+        void row(const char* name, std::uint64_t n, const test_result& r, double seconds)
+        {
+            ++tests;
+            const char* verdict = "ok";
+            if (!(r.p >= fail_p))
+            {
+                verdict = "FAIL";
+                ++failed;
+            }
+            else if (r.p < weak_p)
+            {
+                verdict = "weak";
+                ++weak;
+            }
+
+            const double rate = seconds > 0.0 ? static_cast<double>(n) / seconds * 1e-6 : 0.0;
+            if (r.df > 0.0)
+                std::printf("%-44s %12llu %12.2f %6.0f %10.3g %6s %10.1f\n", name,
+                            static_cast<unsigned long long>(n), r.stat, r.df, r.p, verdict, rate);
+            else
+                std::printf("%-44s %12llu %12.3g %6s %10.3g %6s %10.1f\n", name,
+                            static_cast<unsigned long long>(n), r.stat, "KS", r.p, verdict, rate);
+        }
+    };
+
+    template <class F>
+    double timed(F&& f)
+    {
+        const auto t0 = std::chrono::steady_clock::now();
+        f();
+        const auto t1 = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(t1 - t0).count();
+    }
+
+    struct config
+    {
+        std::uint64_t seed = 0x0DD5'0DD5'0DD5'0DD5ULL;
+        std::uint64_t scale = 1;
+
+        [[nodiscard]] std::uint64_t n(std::uint64_t base) const noexcept { return base * scale; }
+    };
+
+    // ----------------------------
+    // Bounded uniform
+    // ----------------------------
+    // Values are binned as floor(v * k / bound); bin j then holds exactly
+    // ceil((j+1) * bound / k) - ceil(j * bound / k) of the bound's values.
+    test_result bounded_bins(std::span<const std::uint32_t> v, std::uint64_t bound)
+    {
+        const std::uint64_t k = std::min<std::uint64_t>(bound, 1000);
+        std::vector<std::uint64_t> observed(k, 0);
+        for (const std::uint32_t x : v)
+        {
+            if (x >= bound) return { std::numeric_limits<double>::infinity(), 0.0, 0.0 };
+            ++observed[static_cast<std::size_t>(std::uint64_t{x} * k / bound)];
+        }
+
+        std::vector<double> prob(k);
+        const auto ceil_div = [](std::uint64_t a, std::uint64_t b) { return (a + b - 1) / b; };
+        for (std::uint64_t j = 0; j < k; ++j)
+        {
+            const std::uint64_t width = ceil_div((j + 1) * bound, k) - ceil_div(j * bound, k);
+            prob[j] = static_cast<double>(width) / static_cast<double>(bound);
+        }
+        return chi_square(observed, prob, v.size());
+    }
+
+    void test_bounded(report& rep, const config& cfg)
+    {
+        const std::uint64_t n = cfg.n(1u << 24);
+        std::vector<std::uint32_t> v(n);
+        char name[64];
+
+        for (const std::uint32_t bound : { 6u, 100u, 1000003u, 0xC000'0001u })
+        {
+            {
+                xoshiro256ss rng(cfg.seed);
+                const double s = timed([&] { for (std::uint32_t& x : v) x = uniform_bounded(rng, bound); });
+                std::snprintf(name, sizeof(name), "uniform_bounded(%u)", bound);
+                rep.row(name, n, bounded_bins(v, bound), s);
+            }
+            {
+                xoshiro256ss rng(cfg.seed + 1);
+                const bounded_sampler<std::uint32_t> sampler(bound);
+                const double s = timed([&] { for (std::uint32_t& x : v) x = sampler(rng); });
+                std::snprintf(name, sizeof(name), "bounded_sampler(%u)", bound);
+                rep.row(name, n, bounded_bins(v, bound), s);
+            }
+            {
+                xoshiro256ss rng(cfg.seed + 2);
+                const double s = timed([&] { uniform_bounded_fill(rng, bound, std::span<std::uint32_t>(v)); });
+                std::snprintf(name, sizeof(name), "uniform_bounded_fill(%u)", bound);
+                rep.row(name, n, bounded_bins(v, bound), s);
+            }
+            {
+                xoshiro256ss_x8 rng(cfg.seed + 3);
+                const double s = timed([&] { uniform_bounded_fill(rng, bound, std::span<std::uint32_t>(v)); });
+                std::snprintf(name, sizeof(name), "uniform_bounded_fill(%u) x8 lanes", bound);
+                rep.row(name, n, bounded_bins(v, bound), s);
+            }
+        }
+
+        {
+            xoshiro256ss rng(cfg.seed + 4);
+            std::array<std::uint64_t, 7> observed{};
+            const double s = timed([&] {
+                for (std::uint64_t i = 0; i < n; ++i) ++observed[static_cast<std::size_t>(uniform_int(rng, -3, 3) + 3)];
+            });
+            rep.row("uniform_int(-3, 3)", n, chi_square_uniform(observed, n), s);
+        }
+    }
+
+    // ----------------------------
+    // Odds: hit counts against p
+    // ----------------------------
+    test_result hit_test(std::uint64_t hits, std::uint64_t n, double p)
+    {
+        const std::array<std::uint64_t, 2> observed{ hits, n - hits };
+        const std::array<double, 2> prob{ p, 1.0 - p };
+        return chi_square(observed, prob, n);
+    }
+
+    template <class F>
+    void odds_row(report& rep, const char* name, std::uint64_t n, double p, F&& trial)
+    {
+        std::uint64_t hits = 0;
+        const double s = timed([&] {
+            for (std::uint64_t i = 0; i < n; ++i) hits += trial() ? 1 : 0;
+        });
+        rep.row(name, n, hit_test(hits, n, p), s);
+    }
+
+    template <std::uint32_t N>
+    void one_in_t_row(report& rep, const config& cfg, std::uint64_t n)
+    {
+        char name[64];
+        std::snprintf(name, sizeof(name), "one_in_t<%u>", N);
+        xoshiro256ss rng(cfg.seed + N);
+        odds_row(rep, name, n, 1.0 / N, [&] { return one_in_v<N>(rng); });
+    }
+
+    // Popcounts of 64-trial masks against Binomial(64, 1/N): catches
+    // correlation between bit lanes, not just a biased hit rate.
+    test_result mask_popcounts(std::span<const std::uint64_t> masks, std::uint64_t bound)
+    {
+        std::array<std::uint64_t, 65> observed{};
+        for (const std::uint64_t m : masks) ++observed[static_cast<std::size_t>(std::popcount(m))];
+
+        std::array<double, 65> prob{};
+        for (std::uint64_t k = 0; k <= 64; ++k) prob[k] = binomial_pmf(64, 1.0 / static_cast<double>(bound), k);
+        return chi_square(observed, prob, masks.size());
+    }
+
+    void test_odds(report& rep, const config& cfg)
+    {
+        const std::uint64_t n = cfg.n(1u << 24);
+        char name[64];
+
+        for (const std::uint32_t bound : { 2u, 3u, 7u, 100u, 1000u })
+        {
+            const double p = 1.0 / bound;
+            {
+                xoshiro256ss rng(cfg.seed);
+                std::snprintf(name, sizeof(name), "one_in(%u)", bound);
+                odds_row(rep, name, n, p, [&] { return one_in(rng, bound); });
+            }
+            {
+                xoshiro256ss rng(cfg.seed + 1);
+                std::snprintf(name, sizeof(name), "one_in_fast(%u)", bound);
+                odds_row(rep, name, n, p, [&] { return one_in_fast(rng, bound); });
+            }
+            {
+                xoshiro256ss rng(cfg.seed + 2);
+                std::unique_ptr<bool[]> out(new bool[n]);
+                const double s = timed([&] { one_in_fill(rng, bound, std::span<bool>(out.get(), n)); });
+                const std::uint64_t hits = static_cast<std::uint64_t>(std::count(out.get(), out.get() + n, true));
+                std::snprintf(name, sizeof(name), "one_in_fill(%u)", bound);
+                rep.row(name, n, hit_test(hits, n, p), s);
+            }
+            {
+                xoshiro256ss rng(cfg.seed + 3);
+                std::vector<std::uint64_t> masks(n / 64);
+                const double s = timed([&] { one_in_bits(rng, bound, masks); });
+                std::uint64_t hits = 0;
+                for (const std::uint64_t m : masks) hits += static_cast<std::uint64_t>(std::popcount(m));
+                std::snprintf(name, sizeof(name), "one_in_bits(%u) hits", bound);
+                rep.row(name, n, hit_test(hits, masks.size() * 64, p), s);
+                std::snprintf(name, sizeof(name), "one_in_bits(%u) popcount", bound);
+                rep.row(name, masks.size(), mask_popcounts(masks, bound), s);
+            }
+        }
+
+        one_in_t_row<3>(rep, cfg, n);
+        one_in_t_row<7>(rep, cfg, n);
+        one_in_t_row<64>(rep, cfg, n);
+        one_in_t_row<100>(rep, cfg, n);
+        one_in_t_row<1000>(rep, cfg, n);
+
+        {
+            xoshiro256ss rng(cfg.seed + 10);
+            odds_row(rep, "m_in_n(3, 7)", n, 3.0 / 7.0, [&] { return m_in_n(rng, 3u, 7u); });
+        }
+        {
+            xoshiro256ss rng(cfg.seed + 11);
+            odds_row(rep, "m_in_n_t<3, 7>", n, 3.0 / 7.0, [&] { return m_in_n_v<3, 7>(rng); });
+        }
+        {
+            xoshiro256ss rng(cfg.seed + 12);
+            odds_row(rep, "chance_v<percent(35)>", n, 0.35, [&] { return chance_v<probability::percent(35.0)>(rng); });
+        }
+        {
+            xoshiro256ss rng(cfg.seed + 13);
+            odds_row(rep, "bernoulli(0.35)", n, 0.35, [&] { return bernoulli(rng, 0.35); });
+        }
+        {
+            xoshiro256ss rng(cfg.seed + 14);
+            odds_row(rep, "bernoulli(1e-3)", n, 1e-3, [&] { return bernoulli(rng, 1e-3); });
+        }
+    }
+
+    // ----------------------------
+    // Skip-ahead and counts
+    // ----------------------------
+    void test_counts(report& rep, const config& cfg)
+    {
+        {
+            // Gaps between hits: Geometric(1/N), P(g = k) = (1 - p)^k p.
+            const std::uint64_t n = cfg.n(1u << 22);
+            constexpr std::uint32_t bound = 10;
+            const double p = 1.0 / bound;
+            std::vector<std::uint64_t> observed(200, 0);
+            xoshiro256ss rng(cfg.seed + 20);
+            const geometric_skip skip(bound);
+            const double s = timed([&] {
+                for (std::uint64_t i = 0; i < n; ++i)
+                    ++observed[static_cast<std::size_t>(std::min<std::uint64_t>(skip(rng), observed.size() - 1))];
+            });
+
+            std::vector<double> prob(observed.size());
+            for (std::size_t k = 0; k + 1 < prob.size(); ++k) prob[k] = std::pow(1.0 - p, static_cast<double>(k)) * p;
+            prob.back() = std::pow(1.0 - p, static_cast<double>(prob.size() - 1));
+            rep.row("geometric_skip(10) gaps", n, chi_square(observed, prob, n), s);
+        }
+
+        const auto binomial_row = [&](const char* name, std::uint64_t trials, double p, auto draw) {
+            const std::uint64_t n = cfg.n(1u << 22);
+            std::vector<std::uint64_t> observed(trials + 1, 0);
+            const double s = timed([&] {
+                for (std::uint64_t i = 0; i < n; ++i) ++observed[static_cast<std::size_t>(std::min(draw(), trials))];
+            });
+
+            std::vector<double> prob(trials + 1);
+            for (std::uint64_t k = 0; k <= trials; ++k) prob[k] = binomial_pmf(trials, p, k);
+            rep.row(name, n, chi_square(observed, prob, n), s);
+        };
+
+        {
+            xoshiro256ss rng(cfg.seed + 21);
+            binomial_row("binomial(20, 0.3)", 20, 0.3, [&] { return binomial(rng, 20, 0.3); });
+        }
+        {
+            xoshiro256ss rng(cfg.seed + 22);
+            binomial_row("binomial_count(1000, 1 in 10)", 1000, 0.1, [&] { return binomial_count(rng, 1000, 10u); });
+        }
+        {
+            xoshiro256ss rng(cfg.seed + 23);
+            binomial_row("binomial_count(100000, 1 in 1000)", 100000, 1e-3,
+                         [&] { return binomial_count(rng, 100000, 1000u); });
+        }
+    }
+
+    // ----------------------------
+    // Shuffle / sample without replacement
+    // ----------------------------
+    void test_sampling(report& rep, const config& cfg)
+    {
+        {
+            // All 24 orders of 4 elements, indexed by Lehmer code.
+            const std::uint64_t n = cfg.n(1u << 22);
+            std::array<std::uint64_t, 24> observed{};
+            xoshiro256ss rng(cfg.seed + 30);
+            const double s = timed([&] {
+                for (std::uint64_t i = 0; i < n; ++i)
+                {
+                    std::array<int, 4> v{ 0, 1, 2, 3 };
+                    shuffle(rng, std::span<int>(v));
+                    int code = 0;
+                    for (int a = 0; a < 4; ++a)
+                    {
+                        int smaller = 0;
+                        for (int b = a + 1; b < 4; ++b) smaller += v[b] < v[a] ? 1 : 0;
+                        code = code * (4 - a) + smaller;
+                    }
+                    ++observed[static_cast<std::size_t>(code)];
+                }
+            });
+            rep.row("shuffle(4) permutations", n, chi_square_uniform(observed, n), s);
+        }
+
+        // Final position of element 0; for large arrays, positions binned.
+        const auto position_row = [&](const char* name, std::size_t size, std::uint64_t shuffles, std::size_t bins) {
+            std::vector<std::uint32_t> v(size);
+            std::vector<std::uint64_t> observed(bins, 0);
+            xoshiro256ss rng(cfg.seed + 31 + size);
+            double s = 0.0;
+            for (std::uint64_t i = 0; i < shuffles; ++i)
+            {
+                for (std::size_t j = 0; j < size; ++j) v[j] = static_cast<std::uint32_t>(j);
+                s += timed([&] { shuffle(rng, std::span<std::uint32_t>(v)); });
+                const std::size_t pos = static_cast<std::size_t>(std::find(v.begin(), v.end(), 0u) - v.begin());
+                ++observed[pos * bins / size];
+            }
+            rep.row(name, shuffles, chi_square_uniform(observed, shuffles), s / static_cast<double>(size));
+        };
+        position_row("shuffle(1000) position of 0", 1000, cfg.n(1u << 16), 1000);
+        position_row("shuffle(20000) position of 0", 20000, cfg.n(1u << 13), 200);
+
+        // Each element is included with p = k/n and pairwise covariance
+        // -p(1-p)/(n-1), so sum (c - e)^2 / (S p (1-p) n/(n-1)) ~ chi2(n-1).
+        const auto sample_row = [&](const char* name, std::uint32_t universe, std::size_t k, std::uint64_t samples) {
+            std::vector<std::uint32_t> out(k);
+            std::vector<std::uint64_t> observed(universe, 0);
+            xoshiro256ss rng(cfg.seed + 40 + universe);
+            double s = 0.0;
+            for (std::uint64_t i = 0; i < samples; ++i)
+            {
+                s += timed([&] { sample_k(rng, universe, k, std::span<std::uint32_t>(out)); });
+                for (const std::uint32_t x : out) ++observed[x];
+            }
+
+            const double p = static_cast<double>(k) / universe;
+            const double e = static_cast<double>(samples) * p;
+            const double var = e * (1.0 - p) * universe / (universe - 1.0);
+            double stat = 0.0;
+            for (const std::uint64_t c : observed)
+            {
+                const double d = static_cast<double>(c) - e;
+                stat += d * d / var;
+            }
+            const double df = universe - 1.0;
+            rep.row(name, samples, { stat, df, chi_square_p(stat, df) }, s / static_cast<double>(k));
+        };
+        sample_row("sample_k(10, 3) Floyd", 10, 3, cfg.n(1u << 20));
+        sample_row("sample_k(64, 20) partial shuffle", 64, 20, cfg.n(1u << 18));
+        sample_row("sample_k(1000, 100) Floyd set", 1000, 100, cfg.n(1u << 14));
+    }
+
+    // ----------------------------
+    // Weighted tables
+    // ----------------------------
+    void test_weighted(report& rep, const config& cfg)
+    {
+        const std::uint64_t n = cfg.n(1u << 24);
+        {
+            const std::array<double, 6> weights{ 1.0, 2.0, 3.0, 4.0, 0.0, 10.0 };
+            const weighted_table table(weights);
+            std::vector<std::uint32_t> out(n);
+            xoshiro256ss rng(cfg.seed + 50);
+            const double s = timed([&] { table.fill(rng, out); });
+
+            std::array<std::uint64_t, 6> observed{};
+            for (const std::uint32_t i : out) ++observed[i];
+            std::array<double, 6> prob{};
+            for (std::size_t i = 0; i < 6; ++i) prob[i] = weights[i] / 20.0;
+            rep.row("weighted_table fill", n, chi_square(observed, prob, n), s);
+        }
+        {
+            const std::array<std::uint64_t, 5> weights{ 5, 1, 0, 7, 3 };
+            const dynamic_weighted_table table(weights);
+            std::array<std::uint64_t, 5> observed{};
+            xoshiro256ss rng(cfg.seed + 51);
+            const double s = timed([&] {
+                for (std::uint64_t i = 0; i < n; ++i) ++observed[table(rng)];
+            });
+            std::array<double, 5> prob{};
+            for (std::size_t i = 0; i < 5; ++i) prob[i] = static_cast<double>(weights[i]) / 16.0;
+            rep.row("dynamic_weighted_table", n, chi_square(observed, prob, n), s);
+        }
+    }
+
+    // ----------------------------
+    // Continuous distributions
+    // ----------------------------
+    template <class Cdf>
+    test_result binned_continuous(std::span<const double> x, double lo, double hi, std::size_t bins, Cdf cdf)
+    {
+        // Cell 0 is (-inf, lo), the last cell [hi, inf).
+        std::vector<std::uint64_t> observed(bins + 2, 0);
+        const double width = (hi - lo) / static_cast<double>(bins);
+        for (const double v : x)
+        {
+            std::size_t c = 0;
+            if (v >= hi) c = bins + 1;
+            else if (v >= lo) c = 1 + std::min(bins - 1, static_cast<std::size_t>((v - lo) / width));
+            ++observed[c];
+        }
+
+        std::vector<double> prob(bins + 2);
+        prob[0] = cdf(lo);
+        for (std::size_t i = 0; i < bins; ++i)
+            prob[i + 1] = cdf(lo + width * static_cast<double>(i + 1)) - cdf(lo + width * static_cast<double>(i));
+        prob[bins + 1] = 1.0 - cdf(hi);
+        return chi_square(observed, prob, x.size());
+    }
+
+    void test_continuous(report& rep, const config& cfg)
+    {
+        const std::uint64_t n_ks = cfg.n(1u << 20);
+        const std::uint64_t n_bins = cfg.n(1u << 24);
+
+        const auto ks_row = [&](const char* name, auto cdf, auto draw) {
+            std::vector<double> x(n_ks);
+            const double s = timed([&] { draw(std::span<double>(x)); });
+            rep.row(name, n_ks, kolmogorov_smirnov(x, cdf), s);
+        };
+
+        {
+            xoshiro256ss rng(cfg.seed + 60);
+            ks_row("uniform_double KS", uniform_cdf, [&](std::span<double> x) { uniform_double_fill(rng, x); });
+        }
+        {
+            xoshiro256ss rng(cfg.seed + 61);
+            ks_row("uniform_float KS", uniform_cdf, [&](std::span<double> x) {
+                for (double& v : x) v = uniform_float(rng);
+            });
+        }
+        {
+            xoshiro256ss rng(cfg.seed + 62);
+            ks_row("normal KS", normal_cdf, [&](std::span<double> x) {
+                for (double& v : x) v = normal(rng);
+            });
+        }
+        {
+            xoshiro256ss rng(cfg.seed + 63);
+            ks_row("normal_fill KS", normal_cdf, [&](std::span<double> x) { normal_fill(rng, x); });
+        }
+        {
+            xoshiro256ss rng(cfg.seed + 64);
+            ks_row("exponential KS", exponential_cdf, [&](std::span<double> x) {
+                for (double& v : x) v = exponential(rng);
+            });
+        }
+        {
+            xoshiro256ss rng(cfg.seed + 65);
+            ks_row("exponential_fill KS", exponential_cdf, [&](std::span<double> x) { exponential_fill(rng, x); });
+        }
+
+        // KS barely sees the tails; binned chi-square out to 6 sigma does.
+        {
+            std::vector<double> x(n_bins);
+            xoshiro256ss rng(cfg.seed + 66);
+            const double s = timed([&] { normal_fill(rng, std::span<double>(x)); });
+            rep.row("normal_fill bins [-6, 6]", n_bins, binned_continuous(x, -6.0, 6.0, 96, normal_cdf), s);
+        }
+        {
+            std::vector<double> x(n_bins);
+            xoshiro256ss rng(cfg.seed + 67);
+            const double s = timed([&] { exponential_fill(rng, std::span<double>(x)); });
+            rep.row("exponential_fill bins [0, 20]", n_bins, binned_continuous(x, 0.0, 20.0, 80, exponential_cdf), s);
+        }
+    }
+
+    // ----------------------------
+    // Engines: raw streams and throughput
+    // ----------------------------
+    template <class Engine>
+    void fill_words(Engine& rng, std::span<std::uint64_t> out)
+    {
+        if constexpr (requires { rng.fill(out); })
+            rng.fill(out);
+        else
+            for (std::uint64_t& w : out) w = rng.next_u64();
+    }
+
+    // PractRand / TestU01 read native-order words; write little-endian.
+    void to_little_endian(std::span<std::uint64_t> words)
+    {
+        if constexpr (std::endian::native == std::endian::big)
+            for (std::uint64_t& w : words) w = std::byteswap(w);
+    }
+
+    template <class Engine>
+    int run_stream(std::uint64_t seed, std::uint64_t bytes)
+    {
+        Engine rng(seed);
+        std::vector<std::uint64_t> buf(1u << 13);
+        const bool endless = bytes == 0;
+
+        while (endless || bytes != 0)
+        {
+            fill_words(rng, buf);
+            to_little_endian(buf);
+            const std::size_t want = endless ? buf.size() * 8 : static_cast<std::size_t>(std::min<std::uint64_t>(bytes, buf.size() * 8));
+            if (std::fwrite(buf.data(), 1, want, stdout) != want) return 0; // reader closed the pipe
+            if (!endless) bytes -= want;
+        }
+        std::fflush(stdout);
+        return 0;
+    }
+
+    volatile std::uint64_t observed_sink = 0;
+
+    template <class Engine>
+    double engine_gbps(std::uint64_t seed, std::uint64_t words)
+    {
+        Engine rng(seed);
+        std::vector<std::uint64_t> buf(1u << 13);
+        std::uint64_t sink = 0;
+        const double s = timed([&] {
+            for (std::uint64_t done = 0; done < words; done += buf.size())
+            {
+                fill_words(rng, buf);
+                sink ^= buf[done % buf.size()];
+            }
+        });
+        observed_sink = sink; // keeps the fills from being optimised away
+        return static_cast<double>(words) * 8.0 / s * 1e-9;
+    }
+
+    struct engine_entry
+    {
+        std::string_view name;
+        int (*stream)(std::uint64_t, std::uint64_t);
+        double (*gbps)(std::uint64_t, std::uint64_t);
+    };
+
+    template <class Engine>
+    constexpr engine_entry entry(std::string_view name)
+    {
+        return { name, &run_stream<Engine>, &engine_gbps<Engine> };
+    }
+
+    constexpr std::array engines{
+        entry<xoshiro256ss>("xoshiro256ss"),
+        entry<xoshiro256ss_x4>("xoshiro256ss_x4"),
+        entry<xoshiro256ss_x8>("xoshiro256ss_x8"),
+        entry<philox4x32>("philox4x32"),
+        entry<wyrand>("wyrand"),
+        entry<romu_duo_jr>("romu_duo_jr"),
+        entry<xoroshiro128p>("xoroshiro128p"),
+        entry<pcg64_dxsm>("pcg64_dxsm"),
+    };
+
+    void print_throughput(const config& cfg)
+    {
+        std::printf("%-20s %10s\n", "engine", "GB/s");
+        for (const engine_entry& e : engines)
+            std::printf("%-20.*s %10.2f\n", static_cast<int>(e.name.size()), e.name.data(), e.gbps(cfg.seed, cfg.n(1u << 26)));
+    }
+
+    int usage()
+    {
+        std::fprintf(stderr,
+                     "usage: ayejay_odds_validate [tests] [--seed S] [--scale K]\n"
+                     "       ayejay_odds_validate stream [engine] [--seed S] [--bytes N]\n"
+                     "       ayejay_odds_validate throughput [--scale K]\n"
+                     "engines:");
+        for (const engine_entry& e : engines)
+            std::fprintf(stderr, " %.*s", static_cast<int>(e.name.size()), e.name.data());
+        std::fprintf(stderr, "\n");
+        return 2;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string_view mode = "tests";
+    std::string_view engine = "xoshiro256ss";
+    config cfg;
+    std::uint64_t bytes = 0;
+
+    int i = 1;
+    if (i < argc && argv[i][0] != '-') mode = argv[i++];
+    if (mode == "stream" && i < argc && argv[i][0] != '-') engine = argv[i++];
+
+    for (; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (i + 1 >= argc) return usage();
+        const std::uint64_t value = std::strtoull(argv[++i], nullptr, 0);
+        if (arg == "--seed") cfg.seed = value;
+        else if (arg == "--scale") cfg.scale = std::max<std::uint64_t>(value, 1);
+        else if (arg == "--bytes") bytes = value;
+        else return usage();
+    }
+    if (bytes != 0 && mode != "stream") return usage();
+
+    if (mode == "stream")
+    {
+#if defined(_WIN32)
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        for (const engine_entry& e : engines)
+            if (e.name == engine) return e.stream(cfg.seed, bytes);
+        return usage();
+    }
+
+    if (mode == "throughput")
+    {
+        print_throughput(cfg);
+        return 0;
+    }
+
+    if (mode != "tests") return usage();
+
+    report rep;
+    std::printf("seed 0x%016llx, scale %llu\n\n", static_cast<unsigned long long>(cfg.seed),
+                static_cast<unsigned long long>(cfg.scale));
+    rep.header();
+    test_bounded(rep, cfg);
+    test_odds(rep, cfg);
+    test_counts(rep, cfg);
+    test_sampling(rep, cfg);
+    test_weighted(rep, cfg);
+    test_continuous(rep, cfg);
+
+    std::printf("\n");
+    print_throughput(cfg);
+
+    std::printf("\n%d tests, %d weak (p < %g), %d failed (p < %g)\n", rep.tests, rep.weak, weak_p, rep.failed, fail_p);
+    return rep.failed == 0 ? 0 : 1;
+}